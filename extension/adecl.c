@@ -15,6 +15,8 @@ static char *adeclLoadStore(LoadStore_IR loadStoreIr);
 
 static char *adeclBranch(Branch_IR branchIr);
 
+static char *adeclBarrier(Barrier_IR barrierIr);
+
 /// Translates [irObject] to its human readable description.
 /// @param irObject The instruction to interpret.
 /// @returns The human readable description.
@@ -33,6 +35,9 @@ char *adecl(IR *irObject) {
         case BRANCH: {
             return adeclBranch(irObject->ir.branchIR);
         }
+        case BARRIER: {
+            return adeclBarrier(irObject->ir.barrierIR);
+        }
         case DIRECTIVE: {
             char *str;
             asprintf(&str,
@@ -80,6 +85,9 @@ static char *adeclImmediate(Immediate_IR immediateIR) {
                 case SUBS:
                     format = "%s R%d = R%d - %d w/ flags";
                     break;
+
+                default:
+                    throwFatal("Unrecognised arithmetic type!");
             }
 
             asprintf(&str,
@@ -117,6 +125,9 @@ static char *adeclImmediate(Immediate_IR immediateIR) {
                              immediateIR.operand.wideMove.imm16);
                     return str;
                 }
+
+                default:
+                    throwFatal("Unrecognised wide move type!");
             }
 
             asprintf(&str,
@@ -128,6 +139,9 @@ static char *adeclImmediate(Immediate_IR immediateIR) {
             shiftVal = 16 * immediateIR.operand.wideMove.hw;
             break;
         }
+
+        default:
+            throwFatal("Unrecognised immediate instruction!");
     }
     return applyShiftFormat(str, LSL, shiftVal);
 }
@@ -163,6 +177,9 @@ static char *adeclRegister(Register_IR registerIr) {
                 case SUBS:
                     format = "%s R%d = R%d - R%d w/ flags";
                     break;
+
+                default:
+                    throwFatal("Unrecognised arithmetic type!");
             }
             break;
 
@@ -189,6 +206,9 @@ static char *adeclRegister(Register_IR registerIr) {
                     case BICS:
                         format = "%s R%d = R%d & ∼R%d w/ flags";
                         break;
+
+                    default:
+                        throwFatal("Unrecognised bit-logic type!");
                 }
             } else {
                 switch (registerIr.opc.logic.standard) {
@@ -211,6 +231,9 @@ static char *adeclRegister(Register_IR registerIr) {
                     case ANDS:
                         format = "%s R%d = R%d & R%d w/ flags";
                         break;
+
+                    default:
+                        throwFatal("Unrecognised bit-logic type!");
                 }
             }
             break;
@@ -227,6 +250,9 @@ static char *adeclRegister(Register_IR registerIr) {
                 case MSUB:
                     format = "%s R%d = R%d - (R%d * R%d)";
                     break;
+
+                default:
+                    throwFatal("Unrecognised multiply type!");
             }
 
             asprintf(&str,
@@ -238,6 +264,9 @@ static char *adeclRegister(Register_IR registerIr) {
                      registerIr.rm);
 
             return str;
+
+        default:
+            throwFatal("Unrecognised register instruction!");
     }
     // Arithmetic or Big-logic.
     // Create the base string without shift.
@@ -369,6 +398,24 @@ static char *adeclLoadStore(LoadStore_IR loadStoreIr) {
                          loadStoreIr.data.simm19.data.immediate);
             }
             break;
+
+        // Exclusive monitor on Xn; Ws := 0 if the store succeeded
+        case LOAD_STORE_EXCLUSIVE:
+            if (loadStoreIr.data.exclusive.l) {
+                asprintf(&str,
+                         "%s R%d = M[R%d], exclusively",
+                         nBits,
+                         loadStoreIr.rt,
+                         loadStoreIr.data.exclusive.xn);
+            } else {
+                asprintf(&str,
+                         "%s M[R%d] = R%d if exclusive, R%d = failed",
+                         nBits,
+                         loadStoreIr.data.exclusive.xn,
+                         loadStoreIr.rt,
+                         loadStoreIr.data.exclusive.rs);
+            }
+            break;
     }
     return str;
 }
@@ -419,6 +466,28 @@ static char *adeclBranch(Branch_IR branchIr) {
     return str;
 }
 
+/// Translates [barrierIr] to its human readable description.
+/// @param barrierIr The barrier instruction to interpret.
+/// @returns The human readable description.
+static char *adeclBarrier(Barrier_IR barrierIr) {
+    char *str;
+
+    switch (barrierIr.type) {
+        case DMB:
+            asprintf(&str, "Order memory accesses");
+            break;
+
+        case DSB:
+            asprintf(&str, "Complete memory accesses");
+            break;
+
+        case ISB:
+            asprintf(&str, "Refetch instructions");
+            break;
+    }
+    return str;
+}
+
 /// Adds the shift description to the human readable description.
 /// @param str The human readable description.
 /// @param shift The shift stored in the IR.
@@ -448,6 +517,9 @@ static char *applyShiftFormat(char *str, enum ShiftType shift, int shiftVal) {
         case ROR:
             shiftType = "ROR";
             break;
+
+        default:
+            throwFatal("Unrecognised shift type!");
     }
 
     // Check if "/w" already in string and act accordingly.
@@ -485,6 +557,46 @@ static char *getBranchCondition(enum BranchCondition condition) {
         case NE:
             return "!=";
 
+        // Unsigned greater or equal to.
+        // C == 1
+        case CS:
+            return "unsigned >=";
+
+        // Unsigned less than.
+        // C == 0
+        case CC:
+            return "unsigned <";
+
+        // Negative.
+        // N == 1
+        case MI:
+            return "negative";
+
+        // Positive or zero.
+        // N == 0
+        case PL:
+            return "positive or zero";
+
+        // Overflow.
+        // V == 1
+        case VS:
+            return "overflow";
+
+        // No overflow.
+        // V == 0
+        case VC:
+            return "no overflow";
+
+        // Unsigned greater than.
+        // C == 1 && Z == 0
+        case HI:
+            return "unsigned >";
+
+        // Unsigned less than or equal to.
+        // !(C == 1 && Z == 0)
+        case LS:
+            return "unsigned <=";
+
         // Signed greater or equal to.
         // N == V
         case GE:
@@ -508,6 +620,7 @@ static char *getBranchCondition(enum BranchCondition condition) {
         // Always branches (no condition).
         // Any [PState] flags.
         case AL:
+        case NV:
             return "always";
     }
     return "";
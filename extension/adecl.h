@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "error.h"
 #include "ir.h"
 
 char *adecl(IR *irObject);
@@ -13,6 +13,10 @@ static void updateUI(void);
 
 static void printSpaced(WINDOW *window, int row, int count, char **content);
 
+static void endDebug(Memory *debugMemory);
+
+static void followPC(void);
+
 int main(int argc, char *argv[]) {
     initialise((argc > 1) ? argv[1] : NULL);
 
@@ -22,8 +26,11 @@ int main(int argc, char *argv[]) {
     // Has the debug mode terminated execution?
     bool finishedExecuting = false;
 
-    // The memory for debug mode.
-    Memory debugMemory;
+    // The memory for debug mode, or NULL outside of it.
+    Memory debugMemory = NULL;
+
+    // The memory for running, reset rather than reallocated between runs.
+    Memory runMemory = allocMem();
 
     int key = -1;
     while (key != QUIT_KEY) {
@@ -49,7 +56,7 @@ int main(int argc, char *argv[]) {
                 // Initialise registers, memory, and assembler state.
                 Registers_s registersStruct = createRegs();
                 Registers registers = &registersStruct;
-                Memory memory = allocMem();
+                Memory memory = runMemory;
                 AssemblerState state = createState();
 
                 // Initialise error string.
@@ -72,12 +79,10 @@ int main(int argc, char *argv[]) {
                         state.address += 0x4;
                     }
 
-                    // Fetch first instruction.
-                    Instruction instruction = readMem(memory, false, getRegPC(registers));
-
-                    // Fetch, decode, execute cycle while the program has not terminated.
-                    while (instruction != HALT) {
-                        execute(&instruction, registers, memory);
+                    // Fetch, decode, execute cycle while the program has not terminated, nor run for too long.
+                    if (runFor(registers, memory, BLOCK_ENGINE, GRIM_RUN_BUDGET) == STOP_BUDGET) {
+                        throwFatalWithArgs("Stopped after %" PRIu64 " instructions without halting!",
+                                           registers->instructions);
                     }
 
                 }
@@ -87,8 +92,8 @@ int main(int argc, char *argv[]) {
 
                 wmove(editor, file->lineNumber, file->cursor);
 
-                // Free the emulator and assembler states.
-                freeMem(memory);
+                // Reset the emulator state, and free the assembler state.
+                resetMem(memory);
                 destroyState(state);
 
                 clearLastRegs();
@@ -104,11 +109,7 @@ int main(int argc, char *argv[]) {
                 // Toggle debug mode.
                 if (mode == DEBUG) {
                     // If manually exiting debug, terminate the execution.
-                    mode = EDIT;
-                    status = UNSAVED;
-                    freeMem(debugMemory);
-                    free(addrLines);
-                    clearLastRegs();
+                    endDebug(&debugMemory);
                     break;
                 } else {
                     mode = DEBUG;
@@ -118,8 +119,8 @@ int main(int argc, char *argv[]) {
                 // Initialise the addrLines array.
                 addrLines = malloc(file->size * sizeof(AddrLine));
 
-                // The index of the current instruction
-                int instructionIndex = 0;
+                // The index of the current instruction, volatile as it changes between [setjmp] and any [longjmp].
+                volatile int instructionIndex = 0;
 
                 // Initialise registers, memory, and assembler state.
                 debugRegistersStruct = createRegs();
@@ -162,6 +163,9 @@ int main(int argc, char *argv[]) {
 
                     destroyState(state);
 
+                    // Every step from here on can be undone.
+                    debugLog = createUndoLog(&debugRegistersStruct, debugMemory, UNDO_LOG_WORDS);
+
                     pcValue = 0x0;
                 } else {
                     // Fatal error encountered during execution
@@ -169,10 +173,6 @@ int main(int argc, char *argv[]) {
                     // Update the side window.
                     updateDebug(&debugRegistersStruct);
 
-                    // Free the memory
-                    freeMem(debugMemory);
-                    free(addrLines);
-
                     finishedExecuting = true;
                 }
 
@@ -187,41 +187,50 @@ int main(int argc, char *argv[]) {
                 if (mode == DEBUG && key == '\n') {
                     if (finishedExecuting) {
                         // If the program finished execution because of a fatal error.
-                        mode = EDIT;
-                        status = UNSAVED;
-                        clearLastRegs();
-                        break;
-                    }
-                    // Run the current instruction.
-
-                    // Fetch instruction.
-                    Instruction instruction = readMem(debugMemory, false, getRegPC(&debugRegistersStruct));
-
-                    // Go back to edit mode if the instruction was a halt.
-                    if (instruction == HALT) {
-                        mode = EDIT;
-                        status = UNSAVED;
-                        freeMem(debugMemory);
-                        free(addrLines);
-                        clearLastRegs();
+                        endDebug(&debugMemory);
                         break;
                     }
 
-                    // Execute the instruction.
-                    execute(&instruction, &debugRegistersStruct, debugMemory);
-                    finishedExecuting = false;
+                    // Run the current instruction, going back to edit mode if it was a halt. A fault leaves the
+                    // instruction unexecuted, so that the steps up to it can still be undone.
+                    switch (stepForward(debugLog, &debugRegistersStruct, debugMemory)) {
+                        case STOP_HALTED:
+                            endDebug(&debugMemory);
+                            break;
 
-                    pcValue = getRegPC(&debugRegistersStruct);
+                        case STOP_FAULT:
+                            finishedExecuting = true;
+                            break;
 
-                    // Scroll to the line now being executed.
-                    for (int addrLineIndex = 0; addrLineIndex < file->size; addrLineIndex++) {
-                        AddrLine currAddrLine = addrLines[addrLineIndex];
-                        if (currAddrLine.address == pcValue) {
-                            file->lineNumber = currAddrLine.line;
+                        case STOP_BUDGET:
+                            followPC();
                             break;
+                    }
+
+                    break;
+                }
+
+                if (mode == DEBUG && debugLog != NULL
+                    && (key == STEP_BACK_KEY || key == 127 || key == REVERSE_PC_KEY || key == REVERSE_WRITE_KEY)) {
+                    BitData address = 0;
+                    if (key == REVERSE_PC_KEY && !showAddressOverlay("Back To PC", &address)) break;
+                    if (key == REVERSE_WRITE_KEY && !showAddressOverlay("Back To Write Of", &address)) break;
+
+                    // Stepping back from a fault goes back to before the faulting instruction.
+                    finishedExecuting = false;
+                    fatalError[0] = '\0';
+
+                    if (key == REVERSE_PC_KEY) {
+                        reverseToPC(debugLog, &debugRegistersStruct, debugMemory, address);
+                    } else if (key == REVERSE_WRITE_KEY) {
+                        if (address <= debugMemory->size - sizeof(uint64_t)) {
+                            reverseToWrite(debugLog, &debugRegistersStruct, debugMemory, true, address);
                         }
+                    } else {
+                        stepBack(debugLog, &debugRegistersStruct, debugMemory);
                     }
 
+                    followPC();
                     break;
                 }
 
@@ -238,8 +247,8 @@ int main(int argc, char *argv[]) {
         : (showSaveOverlay(file) ? SAVED : status);
 
     // Cleanup
+    freeMem(runMemory);
     freeFile(file);
-    free(fatalError);
     endwin();
 
     return 0;
@@ -265,8 +274,8 @@ static void rerenderLineWrapper(Line *line, int index) {
 /// Initialises the editor.
 /// @param path The path to the file to open, or NULL if no file is to be opened.
 static void initialise(const char *path) {
-    // fatalError is "realloc"ed elsewhere.
-    fatalError = malloc(0);
+    // Errors are shown in the editor, rather than exiting it.
+    JUMP_ON_ERROR = true;
 
     // Initialise the saved registered for difference highlighting.
     clearLastRegs();
@@ -377,7 +386,7 @@ static void updateUI(void) {
     // Update bottom help bar.
     wattron(help, A_BOLD);
     werase(help);
-    printSpaced(help, 0, 5, (char **) commands);
+    printSpaced(help, 0, 5, (char **) (mode == DEBUG ? debugCommands : commands));
     wattroff(help, A_BOLD);
     wrefresh(help);
 
@@ -461,3 +470,34 @@ static void printSpaced(WINDOW *window, int row, int count, char **content) {
     if (count == 1) return;
     mvwaddstr(window, row, cols - (int) strlen(content[count - 1]), content[count - 1]);
 }
+
+/// Leaves debug mode, freeing everything it allocated.
+/// @param debugMemory The memory for debug mode, set to NULL once freed.
+static void endDebug(Memory *debugMemory) {
+    mode = EDIT;
+    status = UNSAVED;
+
+    if (debugLog != NULL) freeUndoLog(debugLog);
+    debugLog = NULL;
+
+    if (*debugMemory != NULL) freeMem(*debugMemory);
+    *debugMemory = NULL;
+
+    free(addrLines);
+    addrLines = NULL;
+
+    clearLastRegs();
+}
+
+/// Moves the debug line to the instruction at the PC, scrolling to it.
+static void followPC(void) {
+    pcValue = getRegPC(&debugRegistersStruct);
+
+    for (int addrLineIndex = 0; addrLineIndex < file->size; addrLineIndex++) {
+        AddrLine currAddrLine = addrLines[addrLineIndex];
+        if (currAddrLine.address == pcValue) {
+            file->lineNumber = currAddrLine.line;
+            break;
+        }
+    }
+}
@@ -13,6 +13,7 @@
 #include <setjmp.h>
 #include <stdio.h>
 
+#include "addressOverlay.h"
 #include "assemblerDelegate.h"
 #include "binarySide.h"
 #include "debugSide.h"
@@ -26,9 +27,7 @@
 #include "saveOverlay.h"
 #include "state.h"
 #include "termSizeOverlay.h"
-
-/// The halt instruction for run/debug mode.
-#define HALT 0x8a000000
+#include "undoLog.h"
 
 /// The key-code for CTRL plus some other key.
 #define CTRL(__KEY__) ((__KEY__) & 0x1F)
@@ -48,6 +47,15 @@
 /// The key code to view the compiled assembly.
 #define BINARY_KEY        CTRL('b')
 
+/// The key code to undo the last step in debug mode.
+#define STEP_BACK_KEY     KEY_BACKSPACE
+
+/// The key code to reverse-continue to the last time an instruction was executed, in debug mode.
+#define REVERSE_PC_KEY    CTRL('p')
+
+/// The key code to reverse-continue to the last write to a memory word, in debug mode.
+#define REVERSE_WRITE_KEY CTRL('w')
+
 static const char *commands[6] = {
     "[^Q] - QUIT",
     "[^S] - SAVE",
@@ -57,6 +65,14 @@ static const char *commands[6] = {
     "[ENTER] - STEP",
 };
 
+static const char *debugCommands[5] = {
+    "[^D] - EXIT",
+    "[ENTER] - STEP",
+    "[BKSP] - STEP BACK",
+    "[^P] - BACK TO PC",
+    "[^W] - BACK TO WRITE",
+};
+
 /// The human-readable titles of [EditorMode].
 static const char *modes[] = { "EDIT", "DEBUG", "BINARY" };
 
@@ -84,6 +100,9 @@ BitData pcValue;
 /// The registers for debug mode.
 Registers_s debugRegistersStruct;
 
+/// The log of each step taken in debug mode, so that they can be undone.
+UndoLog debugLog;
+
 /// Associate instruction memory address with the line number it corresponds to.
 typedef struct {
     /// The address of the instruction in memory.
@@ -98,15 +117,6 @@ AddrLine *addrLines;
 /// The flag signifying whether the current line has errored.
 bool lineErrored = false;
 
-/// The flag signifying to [error.h] to not exit the program when an error occurs.
-bool JUMP_ON_ERROR = true;
-
-/// The jump buffer signifying whether an emulate or assemble operation was correct.
-jmp_buf fatalBuffer;
-
-/// The human-readable description of an error, if there was one.
-char *fatalError;
-
 int main(int argc, char *argv[]);
 
 #endif // EXTENSION_EDITOR_H
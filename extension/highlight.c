@@ -11,17 +11,21 @@
 static const char *mnemonics[] = {
         "add",  "adds", "and",
         "and",  "ands", "b",
-        "b.al", "b.eq", "b.ge",
-        "b.gt", "b.le", "b.lt",
-        "b.ne", "bic",  "bics",
-        "br",   "cmn",  "cmp",
-        "eon",  "eor",  "ldr",
-        "madd", "mneg", "mov",
-        "movk", "movn", "movz",
-        "msub", "mul",  "mvn",
-        "neg",  "negs", "orn",
-        "orr",  "str",  "sub",
-        "subs", "tst"
+        "b.al", "b.cc", "b.cs",
+        "b.eq", "b.ge", "b.gt",
+        "b.hi", "b.hs", "b.le",
+        "b.lo", "b.ls", "b.lt",
+        "b.mi", "b.ne", "b.nv",
+        "b.pl", "b.vc", "b.vs",
+        "bic",  "bics", "br",
+        "cmn",  "cmp",  "eon",
+        "eor",  "ldr",  "madd",
+        "mneg", "mov",  "movk",
+        "movn", "movz", "msub",
+        "mul",  "mvn",  "neg",
+        "negs", "orn",  "orr",
+        "str",  "sub",  "subs",
+        "tst"
 };
 
 /// Compare pointers to strings by the strings to which they point.
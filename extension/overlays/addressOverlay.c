@@ -0,0 +1,78 @@
+///
+/// addressOverlay.c
+/// The overlay displayed when the user is asked for an address to reverse-continue to.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "addressOverlay.h"
+
+static const char *overlayText = "[ Not an address! ]";
+
+static const int overlayLength = 19;
+
+static const char *promptFormat = "[ %s: %s ]";
+
+/// Asks the user for an address, in hexadecimal (with or without \code 0x \endcode) or decimal.
+/// @param prompt What the address is for.
+/// @param address Where to store the address entered.
+/// @returns Whether an address was entered, rather than the overlay being escaped.
+bool showAddressOverlay(const char *prompt, BitData *address) {
+    WINDOW *addressOverlay = newwin(0, 0, 0, 0);
+    wbkgd(addressOverlay, COLOR_PAIR(MENU_SCHEME));
+    keypad(addressOverlay, TRUE);
+
+    char input[32] = "";
+    int length = 0;
+    int promptLength = (int) strlen(prompt) + 6;
+
+    int key = -1;
+    do {
+        switch (key) {
+            case KEY_BACKSPACE:
+            case 127:
+                if (length > 0) input[--length] = '\0';
+                break;
+
+            case KEY_ENTER:
+            case 10: {
+                char *end;
+                char *trimmed = trim(input, " ");
+                bool valid = trimmed[0] != '\0';
+                if (valid) *address = strtoull(trimmed, &end, strncasecmp(trimmed, "0x", 2) == 0 ? 16 : 10);
+                if (valid && *end == '\0') {
+                    delwin(addressOverlay);
+                    endwin();
+                    return true;
+                }
+
+                mvwaddstr(addressOverlay, rows / 2 + 2, (cols - overlayLength) / 2, overlayText);
+                break;
+            }
+
+            case 27: // ESC key
+                delwin(addressOverlay);
+                endwin();
+                return false;
+
+            default:
+                if (isprint(key) && length < (int) sizeof(input) - 1) {
+                    input[length++] = (char) key;
+                    input[length] = '\0';
+                }
+                break;
+        }
+
+        // Clear the line and render the updated input
+        wmove(addressOverlay, rows / 2, 0);
+        wclrtoeol(addressOverlay);
+        mvwprintw(addressOverlay, rows / 2, (cols - promptLength - length) / 2, promptFormat, prompt, input);
+        wmove(addressOverlay, rows / 2, (cols + promptLength + length) / 2 - 2);
+        wrefresh(addressOverlay);
+    } while ((key = wgetch(addressOverlay)) != KEY_F(1));
+
+    delwin(addressOverlay);
+    endwin();
+
+    return false;
+}
@@ -0,0 +1,24 @@
+///
+/// addressOverlay.h
+/// The overlay displayed when the user is asked for an address to reverse-continue to.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EXTENSION_ADDRESS_OVERLAY_H
+#define EXTENSION_ADDRESS_OVERLAY_H
+
+#include <ctype.h>
+#include <ncurses.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "const.h"
+#include "helpers.h"
+
+extern int rows, cols;
+
+bool showAddressOverlay(const char *prompt, BitData *address);
+
+#endif // EXTENSION_ADDRESS_OVERLAY_H
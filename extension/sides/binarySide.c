@@ -42,12 +42,13 @@ void updateBinary(void) {
         lineInfo[i] = currLineInfo;
     }
 
-    // Keep track of which line we're doing a second pass on, and reset counter.
-    int currLineNum = 0;
+    // Keep track of which line we're doing a second pass on, and reset counter. Both it and the loop counter are
+    // volatile, as they change between [setjmp] and any [longjmp].
+    volatile int currLineNum = 0;
     state.address = 0x0;
 
     // Perform the second pass of the assembler.
-    for (size_t i = 0; i < state.irCount; i++) {
+    for (volatile size_t i = 0; i < state.irCount; i++) {
         // Skip lines which do not require a second pass.
         while (lineInfo[currLineNum].lineStatus != ASSEMBLED) currLineNum++;
 
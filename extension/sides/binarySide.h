@@ -29,10 +29,6 @@ extern EditorMode mode;
 
 extern LineInfo *lineInfo;
 
-extern jmp_buf fatalBuffer;
-
-extern char *fatalError;
-
 void updateBinary(void);
 
 #endif // EXTENSION_BINARY_SIDE_H
@@ -32,10 +32,6 @@ extern EditorMode mode;
 
 extern LineInfo *lineInfo;
 
-extern jmp_buf fatalBuffer;
-
-extern char *fatalError;
-
 void updateDebug(Registers regs);
 
 void clearLastRegs(void);
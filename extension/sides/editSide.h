@@ -30,10 +30,6 @@ extern EditorMode mode;
 
 extern LineInfo *lineInfo;
 
-extern jmp_buf fatalBuffer;
-
-extern char *fatalError;
-
 void updateEdit(void);
 
 #endif // EXTENSION_EDIT_SIDE_H
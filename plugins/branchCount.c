@@ -0,0 +1,87 @@
+///
+/// branchCount.c
+/// An example plugin, which counts the branches a run takes and reports the most taken.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "emulatorPlugin.h"
+
+/// The most distinct branches counted.
+#define MAX_BRANCHES 64
+
+/// A branch, and how many times it was taken.
+typedef struct {
+    /// The address of the branch.
+    BitData from;
+
+    /// The address it moved the PC to.
+    BitData to;
+
+    /// How many times it was taken.
+    uint64_t count;
+} Branch_s;
+
+/// The state of the plugin over a run.
+typedef struct {
+    /// What it was given of the run.
+    const PluginAPI *api;
+
+    /// The distinct branches taken, in the order they were first taken.
+    Branch_s branches[MAX_BRANCHES];
+
+    /// The number of [branches].
+    size_t branchCount;
+
+    /// The number of branches taken, including those not counted individually.
+    uint64_t taken;
+} BranchCount_s;
+
+static BranchCount_s state;
+
+static void onBranch(void *context, const Registers_s *registers, BitData from, BitData to);
+
+const PluginABI emulatorPluginABI = PLUGIN_ABI;
+
+bool emulatorPluginInit(const PluginAPI *api, void **context) {
+    state = (BranchCount_s) { .api = api };
+    api->addBranchHook(api->memory, onBranch, &state);
+    *context = &state;
+    return true;
+}
+
+void emulatorPluginFinish(void *context, StopReason reason) {
+    BranchCount_s *count = context;
+    count->api->removeHooks(count->api->memory, count);
+
+    fprintf(stderr, "branchCount: %" PRIu64 " branches taken before %s.\n", count->taken,
+            reason == STOP_HALTED ? "halting" : reason == STOP_BUDGET ? "running out of budget" : "a fault");
+    for (size_t i = 0; i < count->branchCount; i++) {
+        Branch_s *branch = &count->branches[i];
+        fprintf(stderr, "branchCount: 0x%08" PRIx64 " -> 0x%08" PRIx64 " taken %" PRIu64 " time%s.\n",
+                branch->from, branch->to, branch->count, branch->count == 1 ? "" : "s");
+    }
+}
+
+/// Counts a branch taken.
+/// @param context The [BranchCount_s] of the run.
+/// @param registers The virtual registers, unused.
+/// @param from The address of the branch.
+/// @param to The address it moved the PC to.
+static void onBranch(void *context, const Registers_s *registers, BitData from, BitData to) {
+    (void) registers;
+    BranchCount_s *count = context;
+    count->taken++;
+
+    for (size_t i = 0; i < count->branchCount; i++) {
+        if (count->branches[i].from == from && count->branches[i].to == to) {
+            count->branches[i].count++;
+            return;
+        }
+    }
+
+    if (count->branchCount < MAX_BRANCHES) count->branches[count->branchCount++] = (Branch_s) { from, to, 1 };
+}
@@ -0,0 +1,10 @@
+movz x0, #10
+movz x1, #0
+loop:
+  add x1, x1, x0
+  subs x0, x0, #1
+  b.ne loop
+b done
+  movz x1, #0
+done:
+and x0, x0, x0
@@ -8,28 +8,40 @@
 #include "assemble.h"
 
 /// The entrypoint to the assembler program.
-/// @param argc Number of arguments. Should be 3.
-/// @param argv Arguments. In order: executable name, assembly in, and object code out.
+/// @param argc Number of arguments. Should be 3, or 4 to save the program's symbols.
+/// @param argv Arguments. In order: executable name, assembly in, object code out, and optionally symbols out.
 /// @return Program exit code.
-/// @example \code ./assemble code.s code.o \endcode
+/// @example \code ./assemble code.s code.o code.sym \endcode
 int main(int argc, char **argv) {
-    // Check that [argv] is valid, i.e., has 3 args.
-    if (argc != 3) {
-        printf("Usage: ./assemble code.s out.bin\n");
+    // Check that [argv] is valid, i.e., has 3 or 4 args.
+    if (argc != 3 && argc != 4) {
+        printf("Usage: ./assemble code.s out.bin [out.sym]\n");
         return EXIT_FAILURE;
     };
 
-    // First pass, populate program [state] and generate [IR]s.
+    // First pass, populate program [state] and generate [IR]s, noting the source line of each.
     FILE *fileIn = fopen(argv[1], "r");
     AssemblerState state = createState();
+    Symbols symbols = createSymbols(argv[1]);
     char line[256];
 
-    while (fgets(line, sizeof(line), fileIn)) {
+    for (size_t lineNumber = 1; fgets(line, sizeof(line), fileIn); lineNumber++) {
+        size_t irCount = state.irCount;
         parse(line, &state);
+        if (state.irCount != irCount) addSymbolLine(symbols, state.address - 0x4, lineNumber);
     }
 
     fclose(fileIn);
 
+    // Save the labels and source lines for the emulator's profiler.
+    if (argc == 4) {
+        for (size_t i = 0; i < state.symbolCount; i++) {
+            addSymbolLabel(symbols, state.symbolTable[i].label, state.symbolTable[i].address);
+        }
+        saveSymbols(symbols, argv[3]);
+    }
+    freeSymbols(symbols);
+
     // Second pass, translate IRs to binary instruction based on [state].
     FILE *fileOut = fopen(argv[2], "wb");
 
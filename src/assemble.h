@@ -15,13 +15,10 @@
 
 #include "assemblerDelegate.h"
 #include "helpers.h"
+#include "symbols.h"
 
 int main(int argc, char **argv);
 
 void handleAssembly(char *assembly, AssemblerState *state);
 
-bool JUMP_ON_ERROR = false;
-jmp_buf fatalBuffer;
-char *fatalError;
-
 #endif // ASSEMBLER_ASSEMBLE_H
@@ -19,9 +19,14 @@ static const ParserEntry parsers[] = {
     { "br",   parseBranch },
     { "cmn",  parseDataProcessing },
     { "cmp",  parseDataProcessing },
+    { "dmb",  parseBarrier },
+    { "dsb",  parseBarrier },
     { "eon",  parseRegister },
     { "eor",  parseRegister },
+    { "isb",  parseBarrier },
+    { "ldaxr", parseLoadStore },
     { "ldr",  parseLoadStore },
+    { "ldxr", parseLoadStore },
     { "madd", parseRegister },
     { "mneg", parseDataProcessing },
     { "mov",  parseDataProcessing },
@@ -35,7 +40,9 @@ static const ParserEntry parsers[] = {
     { "negs", parseDataProcessing },
     { "orn",  parseRegister },
     { "orr",  parseRegister },
+    { "stlxr", parseLoadStore },
     { "str",  parseLoadStore },
+    { "stxr", parseLoadStore },
     { "sub",  parseDataProcessing },
     { "subs", parseDataProcessing },
     { "tst",  parseDataProcessing },
@@ -46,6 +53,7 @@ static const TranslatorEntry translators[] = {
     { REGISTER,   translateRegister },
     { LOAD_STORE, translateLoadStore },
     { BRANCH,     translateBranch },
+    { BARRIER,    translateBarrier },
     { DIRECTIVE,  translateDirective },
 };
 
@@ -15,6 +15,8 @@
 #include <string.h>
 #include <stdio.h>
 
+#include "barrierParser.h"
+#include "barrierTranslator.h"
 #include "branchParser.h"
 #include "branchTranslator.h"
 #include "dataProcessingParser.h"
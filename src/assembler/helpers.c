@@ -77,9 +77,10 @@ TokenisedLine tokenise(const char *line) {
     result.subMnemonic = NULL;
 
     char *trimmedLine = trim(lineCopy, ", \n");
-    // Find the first space in the line, separating the mnemonic from the operands.
+    // Find the first space in the line, separating the mnemonic from the operands, if there are any.
     char *separator = strchr(lineCopy, ' ');
-    assertFatal(separator, "Invalid assembly instruction!");
+    bool hasOperands = separator != NULL;
+    if (!hasOperands) separator = trimmedLine + strlen(trimmedLine);
 
     // Extract the mnemonic.
     size_t mnemonicLength = separator - trimmedLine;
@@ -105,6 +106,13 @@ TokenisedLine tokenise(const char *line) {
     result.mnemonic = strndup(trimmedLine, mnemonicLength);
     assertFatalNotNull(result.mnemonic, "<Memory> Unable to duplicate [char *]!");
 
+    if (!hasOperands) {
+        result.operands = NULL;
+        result.operandCount = 0;
+        free(lineCopy);
+        return result;
+    }
+
     // Extract all the operands together.
     char *operands = separator + 1; // New variable for clarity.
 
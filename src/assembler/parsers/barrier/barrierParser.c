@@ -0,0 +1,67 @@
+///
+/// barrierParser.c
+/// Transform a [TokenisedLine] to an [IR] of a Barrier instruction.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "barrierParser.h"
+
+/// The mappings between option names and their encodings.
+/// @attention Must be sorted, for [bsearch].
+static const BarrierEntry options[] = {
+    { "ish",   0xB },
+    { "ishld", 0x9 },
+    { "ishst", 0xA },
+    { "ld",    0xD },
+    { "nsh",   0x7 },
+    { "nshld", 0x5 },
+    { "nshst", 0x6 },
+    { "osh",   0x3 },
+    { "oshld", 0x1 },
+    { "oshst", 0x2 },
+    { "st",    0xE },
+    { "sy",    BARRIER_SY },
+};
+
+/// Performs [strcmp] on the [name]s of [BarrierEntry]s, but takes in [void *]s.
+/// @param v1 The first item.
+/// @param v2 The second item.
+/// @returns [int] of comparison.
+static int barrierCmp(const void *v1, const void *v2) {
+    const BarrierEntry *p1 = (const BarrierEntry *) v1;
+    const BarrierEntry *p2 = (const BarrierEntry *) v2;
+    return strcmp(p1->name, p2->name);
+}
+
+/// Transform a [TokenisedLine] to an [IR] of a barrier instruction.
+/// @param line The [TokenisedLine] of the instruction.
+/// @param state The current state of the assembler.
+/// @returns The [IR] form of the barrier instruction.
+/// @pre The [line]'s mnemonic is that of a barrier instruction.
+/// @remark The option is either named, or given as a 4-bit immediate. Only \code isb \endcode may omit it, in
+/// which case it is \code sy \endcode.
+IR parseBarrier(TokenisedLine *line, unused AssemblerState *state) {
+    enum BarrierType type = DMB;
+    if (!strcmp(line->mnemonic, "dsb")) type = DSB;
+    if (!strcmp(line->mnemonic, "isb")) type = ISB;
+
+    assertFatal(line->operandCount == 1 || (type == ISB && line->operandCount == 0),
+                "Incorrect number of operands; barrier instructions need 1!");
+
+    uint8_t option = BARRIER_SY;
+    if (line->operandCount == 1) {
+        if (line->operands[0][0] == '#') {
+            option = parseImmediateStr(line->operands[0], BARRIER_OPTION_N);
+        } else {
+            BarrierEntry target = (BarrierEntry) { line->operands[0], 0 };
+            BarrierEntry *entry = bsearch(&target, options, sizeof(options) / sizeof(BarrierEntry),
+                                          sizeof(BarrierEntry), barrierCmp);
+            assertFatalNotNullWithArgs(entry, "Invalid barrier option <%s>!", line->operands[0]);
+            option = entry->option;
+        }
+    }
+
+    assertFatal(type != ISB || option == BARRIER_SY, "Invalid barrier option; isb only takes sy!");
+    return (IR) { .type = BARRIER, .ir.barrierIR = (Barrier_IR) { .type = type, .option = option } };
+}
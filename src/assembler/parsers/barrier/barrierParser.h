@@ -0,0 +1,30 @@
+///
+/// barrierParser.h
+/// Transform a [TokenisedLine] to an [IR] of a Barrier instruction.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef ASSEMBLER_BARRIER_PARSER_H
+#define ASSEMBLER_BARRIER_PARSER_H
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "error.h"
+#include "helpers.h"
+#include "ir.h"
+#include "state.h"
+
+/// An entry in a barrier option table.
+typedef struct {
+
+    char *name;
+
+    uint8_t option;
+
+} BarrierEntry;
+
+IR parseBarrier(TokenisedLine *line, unused AssemblerState *state);
+
+#endif // ASSEMBLER_BARRIER_PARSER_H
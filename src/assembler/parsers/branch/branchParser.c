@@ -8,14 +8,26 @@
 #include "branchParser.h"
 
 /// The mappings between condition strings and condition codes.
+/// @attention Must be sorted, for [bsearch].
 static const BranchEntry mappings[] = {
     { "al", AL },
+    { "cc", CC },
+    { "cs", CS },
     { "eq", EQ },
     { "ge", GE },
     { "gt", GT },
+    { "hi", HI },
+    { "hs", CS },
     { "le", LE },
+    { "lo", CC },
+    { "ls", LS },
     { "lt", LT },
+    { "mi", MI },
     { "ne", NE },
+    { "nv", NV },
+    { "pl", PL },
+    { "vc", VC },
+    { "vs", VS },
 };
 
 /// Performs [strcmp] on the [mnemonic]s of [BranchEntry]s, but takes in [void *]s.
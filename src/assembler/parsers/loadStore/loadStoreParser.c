@@ -7,12 +7,16 @@
 
 #include "loadStoreParser.h"
 
+static IR parseExclusive(TokenisedLine *line);
+
 /// Transform a [TokenisedLine] to an [IR] of a load/store instruction.
 /// @param line The [TokenisedLine] of the instruction.
 /// @param state The current state of the assembler.
 /// @returns The [IR] form of the load/store instruction.
 /// @pre The [line]'s mnemonic is that of a load/store instruction.
 IR parseLoadStore(TokenisedLine *line, unused AssemblerState *state) {
+    if (strchr(line->mnemonic, 'x') != NULL) return parseExclusive(line);
+
     assertFatal(line->operandCount == 2 || line->operandCount == 3,
                 "Incorrect number of operands; load-store instructions need 2 or 3!");
     LoadStore_IR loadStoreIR;
@@ -85,3 +89,38 @@ IR parseLoadStore(TokenisedLine *line, unused AssemblerState *state) {
 
     return (IR) { .type = LOAD_STORE, .ir.loadStoreIR = loadStoreIR };
 }
+
+/// Transform a [TokenisedLine] to an [IR] of a load/store exclusive instruction, i.e., one of
+/// \code ldxr Rt, [Xn] \endcode, \code ldaxr Rt, [Xn] \endcode, \code stxr Ws, Rt, [Xn] \endcode, or
+/// \code stlxr Ws, Rt, [Xn] \endcode.
+/// @param line The [TokenisedLine] of the instruction.
+/// @returns The [IR] form of the load/store exclusive instruction.
+static IR parseExclusive(TokenisedLine *line) {
+    bool l = line->mnemonic[0] == 'l';
+    assertFatal(line->operandCount == (l ? 2 : 3),
+                "Incorrect number of operands; load exclusive needs 2, and store exclusive 3!");
+
+    uint8_t rs = LOAD_STORE_EXCLUSIVE_NO_RS;
+    if (!l) rs = parseRegisterStr(line->operands[0], NULL);
+
+    bool sf;
+    const uint8_t rt = parseRegisterStr(line->operands[l ? 0 : 1], &sf);
+
+    uint8_t xn;
+    assertFatal(sscanf(line->operands[l ? 1 : 2], "[%*c%" SCNu8 "]", &xn) == 1, "Could not scan <xn>!");
+
+    struct Exclusive exclusive = (struct Exclusive) {
+        .l = l,
+        .ordered = !strcmp(line->mnemonic, "ldaxr") || !strcmp(line->mnemonic, "stlxr"),
+        .rs = rs,
+        .xn = xn,
+    };
+
+    LoadStore_IR loadStoreIR = (LoadStore_IR) {
+        .sf = sf,
+        .type = LOAD_STORE_EXCLUSIVE,
+        .data.exclusive = exclusive,
+        .rt = rt,
+    };
+    return (IR) { .type = LOAD_STORE, .ir.loadStoreIR = loadStoreIR };
+}
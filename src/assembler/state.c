@@ -94,7 +94,8 @@ void addMapping(AssemblerState *state, char *label, BitData address) {
 
     if (state->symbolCount >= state->symbolMaxCount) {
         // Exponential (doubling) scaling policy.
-        state->symbolTable = realloc(state->symbolTable, state->symbolMaxCount * 2);
+        state->symbolMaxCount *= 2;
+        state->symbolTable = realloc(state->symbolTable, state->symbolMaxCount * sizeof(struct SymbolPair));
         assertFatalNotNull(state->symbolTable, "<Memory> Unable to expand by re-allocate [symbolTable]!");
     }
 
@@ -124,7 +125,8 @@ BitData *getMapping(AssemblerState *state, const char *label) {
 void addIR(AssemblerState *state, IR ir) {
     if (state->irCount >= state->irMaxCount) {
         // Exponential (doubling) scaling policy.
-        state->irList = realloc(state->irList, state->irMaxCount * 2);
+        state->irMaxCount *= 2;
+        state->irList = realloc(state->irList, state->irMaxCount * sizeof(IR));
         assertFatalNotNull(state->irList, "<Memory> Unable to expand by re-allocate [irList]!");
     }
 
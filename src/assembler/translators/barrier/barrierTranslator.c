@@ -0,0 +1,22 @@
+///
+/// barrierTranslator.c
+/// Transform a [IR] of a Barrier instruction to a binary instruction.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "barrierTranslator.h"
+
+/// Converts the IR form of a barrier instruction to a binary word.
+/// @param irObject The [IR] struct representing the instruction.
+/// @param state The current state of the assembler.
+/// @returns 32-bit binary word of the instruction.
+Instruction translateBarrier(IR *irObject, unused AssemblerState *state) {
+    assertFatal(irObject->type == BARRIER, "Received non-barrier IR!");
+    Barrier_IR *barrier = &irObject->ir.barrierIR;
+
+    Instruction result = BARRIER_B;
+    result |= barrier->option << BARRIER_OPTION_S;
+    result |= barrier->type << BARRIER_TYPE_S;
+    return result;
+}
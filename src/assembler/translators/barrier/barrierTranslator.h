@@ -0,0 +1,18 @@
+///
+/// barrierTranslator.h
+/// Transform a [IR] of a Barrier instruction to a binary instruction.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef ASSEMBLER_BARRIER_TRANSLATOR_H
+#define ASSEMBLER_BARRIER_TRANSLATOR_H
+
+#include "const.h"
+#include "error.h"
+#include "ir.h"
+#include "state.h"
+
+Instruction translateBarrier(IR *irObject, unused AssemblerState *state);
+
+#endif // ASSEMBLER_BARRIER_TRANSLATOR_H
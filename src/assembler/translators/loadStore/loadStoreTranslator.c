@@ -62,6 +62,19 @@ Instruction translateLoadStore(IR *irObject, AssemblerState *state) {
                 << LOAD_STORE_LITERAL_SIMM19_S;
             result |= truncater(loadStore->rt, LOAD_STORE_RT_N);
             break;
+
+        case LOAD_STORE_EXCLUSIVE:
+            result = LOAD_STORE_EXCLUSIVE_B;
+            result |= loadStore->sf << LOAD_STORE_SF_S;
+            result |= loadStore->data.exclusive.l << LOAD_STORE_EXCLUSIVE_L_S;
+            result |= loadStore->data.exclusive.rs << LOAD_STORE_EXCLUSIVE_RS_S;
+            result |= loadStore->data.exclusive.ordered << LOAD_STORE_EXCLUSIVE_O0_S;
+            result |= loadStore->data.exclusive.xn << LOAD_STORE_DATA_XN_S;
+            result |= loadStore->rt;
+            break;
+
+        default:
+            throwFatal("Unrecognised load/store type!");
     }
     return result;
 }
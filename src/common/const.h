@@ -12,8 +12,15 @@
 #include <math.h>
 #include <stdint.h>
 
-/// The virtual memory size of the emulated machine.
-#define MEMORY_SIZE      (2 << 20)
+/// The number of bits in a virtual address of the emulated machine.
+#define ADDRESS_BITS     48
+
+/// The size of the (sparse) virtual address space of the emulated machine.
+#define ADDRESS_SPACE    ((uint64_t) 1 << ADDRESS_BITS)
+
+/// The span of low virtual memory, from address 0, whose instructions the threaded and ahead-of-time engines
+/// index directly. Code elsewhere is stepped by the interpreter.
+#define LOW_MEMORY_SIZE  (2 << 20)
 
 /// All considered whitespace characters.
 #define WHITESPACE       " \n\t\r"
@@ -51,6 +58,9 @@
 /// The height (in characters) of the main content.
 #define CONTENT_HEIGHT    ((int) rows - TITLE_HEIGHT - MENU_HEIGHT)
 
+/// The most instructions GRIM runs a program for before giving up on it halting.
+#define GRIM_RUN_BUDGET   100000000
+
 /// Alias for a chunk of data passed to and from the virtual registers or memory.
 typedef uint64_t BitData;
 
@@ -7,16 +7,25 @@
 
 #include "error.h"
 
+// The error state is per-thread, so that each thread catches (and describes) only its own errors.
+
+/// Whether errors jump to [fatalBuffer], rather than exiting the program.
+_Thread_local bool JUMP_ON_ERROR = false;
+
+/// Where errors jump to, if [JUMP_ON_ERROR] is set.
+_Thread_local jmp_buf fatalBuffer;
+
+/// The human-readable description of the last error, preallocated so that raising one never allocates.
+_Thread_local char fatalError[FATAL_MESSAGE_SIZE];
+
 static noreturn void generateFatal(char format[], const char *file, int line, const char *func, va_list args) {
-    char message[1024];
-    vsnprintf(message, sizeof(message), format, args);
+    vsnprintf(fatalError, FATAL_MESSAGE_SIZE, format, args);
     va_end(args);
 
     if (JUMP_ON_ERROR) {
-        fatalError = strdup(message);
         longjmp(fatalBuffer, 1);
     } else {
-        fprintf(stderr, "[%s] %s\n", func, message);
+        fprintf(stderr, "[%s] %s\n", func, fatalError);
         fprintf(stderr, "    In file %s, line %d\n", file, line);
         if (errno) {
             fprintf(stderr, "    With description: %s\n", strerror(errno));
@@ -17,10 +17,12 @@
 #include <stdnoreturn.h>
 #include <string.h>
 
-extern bool JUMP_ON_ERROR;
-extern jmp_buf fatalBuffer;
-extern char *fatalError;
+/// The size of [fatalError], including its terminator; longer messages are truncated.
+#define FATAL_MESSAGE_SIZE 1024
 
+extern _Thread_local bool JUMP_ON_ERROR;
+extern _Thread_local jmp_buf fatalBuffer;
+extern _Thread_local char fatalError[FATAL_MESSAGE_SIZE];
 
 
 /// Assert [__CONDITION__], pretty-printing an error and exiting if it is not met.
@@ -0,0 +1,65 @@
+///
+/// barrier.h
+/// The intermediate representation of a barrier instruction.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef IR_BARRIER_H
+#define IR_BARRIER_H
+
+#include <stdint.h>
+
+#include "const.h"
+#include "types.h"
+
+/// Baseline code for a barrier instruction.
+#define BARRIER_B        b(1101_0101_0000_0011_0011_0000_0001_1111)
+
+/// Mask for a barrier instruction.
+#define BARRIER_M        ((maskl(20)) | (maskr(5)))
+
+/// Number of bits to shift for [option] in a barrier instruction.
+#define BARRIER_OPTION_S 8
+
+/// Number of bits in [option] in a barrier instruction.
+#define BARRIER_OPTION_N 4
+
+/// Mask for [option] in a barrier instruction.
+#define BARRIER_OPTION_M mask(11, 8)
+
+/// Number of bits to shift for [type] in a barrier instruction.
+#define BARRIER_TYPE_S   5
+
+/// Mask for [type] in a barrier instruction.
+#define BARRIER_TYPE_M   mask(7, 5)
+
+/// The option of a full-system barrier, i.e., \code sy \endcode
+#define BARRIER_SY       0xF
+
+/// The intermediate representation of a barrier instruction.
+typedef struct {
+
+    /// The type of barrier.
+    /// @attention Ordinal values represent binary encodings.
+    enum BarrierType {
+
+        /// Data synchronisation barrier: no instruction after it executes until every memory access before it has
+        /// completed.
+        DSB = 0x4,
+
+        /// Data memory barrier: every memory access before it is observed before any after it.
+        DMB = 0x5,
+
+        /// Instruction synchronisation barrier: instructions after it are fetched anew, so see code written (by any
+        /// core) before it.
+        ISB = 0x6,
+
+    } type;
+
+    /// [4b] The domain and access types the barrier applies to, e.g., [BARRIER_SY].
+    uint8_t option;
+
+} Barrier_IR;
+
+#endif // IR_BARRIER_H
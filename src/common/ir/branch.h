@@ -108,6 +108,38 @@ typedef struct {
                 /// \code Z == 0 \endcode
                 NE = 0x1,
 
+                /// Carry set, i.e., unsigned greater or equal to. Also \code hs \endcode.
+                /// \code C == 1 \endcode
+                CS = 0x2,
+
+                /// Carry clear, i.e., unsigned less than. Also \code lo \endcode.
+                /// \code C == 0 \endcode
+                CC = 0x3,
+
+                /// Negative.
+                /// \code N == 1 \endcode
+                MI = 0x4,
+
+                /// Positive or zero.
+                /// \code N == 0 \endcode
+                PL = 0x5,
+
+                /// Overflow.
+                /// \code V == 1 \endcode
+                VS = 0x6,
+
+                /// No overflow.
+                /// \code V == 0 \endcode
+                VC = 0x7,
+
+                /// Unsigned greater than.
+                /// \code C == 1 && Z == 0 \endcode
+                HI = 0x8,
+
+                /// Unsigned less than or equal to.
+                /// \code !(C == 1 && Z == 0) \endcode
+                LS = 0x9,
+
                 /// Signed greater or equal to.
                 /// \code N == V \endcode
                 GE = 0xA,
@@ -126,7 +158,11 @@ typedef struct {
 
                 /// Always branches (no condition).
                 /// Any [PState] flags.
-                AL = 0xE
+                AL = 0xE,
+
+                /// Always branches, as [AL].
+                /// Any [PState] flags.
+                NV = 0xF
 
             } condition;
 
@@ -13,6 +13,7 @@
 #include "register.h"
 #include "loadStore.h"
 #include "branch.h"
+#include "barrier.h"
 
 /// The type of [IR] represented.
 typedef enum {
@@ -29,6 +30,9 @@ typedef enum {
     /// Branch.
     BRANCH,
 
+    /// Barrier.
+    BARRIER,
+
     /// Direct to memory constant.
     DIRECTIVE
 
@@ -55,6 +59,9 @@ typedef struct {
         /// Branch IR.
         Branch_IR branchIR;
 
+        /// Barrier IR.
+        Barrier_IR barrierIR;
+
         /// Data (used by directives) IR.
         BitData memoryData;
 
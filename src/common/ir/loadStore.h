@@ -115,6 +115,33 @@
 /// Number of bits to shift for [sf] in a single data transfer (load / literal) instruction.
 #define LOAD_STORE_SF_S                   30
 
+/// Baseline code for a load/store exclusive instruction.
+#define LOAD_STORE_EXCLUSIVE_B            b(1000_1000_0000_0000_0111_1100_0000_0000)
+
+/// Mask for a load/store exclusive instruction.
+#define LOAD_STORE_EXCLUSIVE_M            ((maskl(1)) | (mask(29, 23)) | (mask(21, 21)) | (mask(14, 10)))
+
+/// Number of bits to shift for [l] in a load/store exclusive instruction.
+#define LOAD_STORE_EXCLUSIVE_L_S          22
+
+/// Mask for [l] in a load/store exclusive instruction.
+#define LOAD_STORE_EXCLUSIVE_L_M          mask(22, 22)
+
+/// Number of bits to shift for [rs] in a load/store exclusive instruction.
+#define LOAD_STORE_EXCLUSIVE_RS_S         16
+
+/// Mask for [rs] in a load/store exclusive instruction.
+#define LOAD_STORE_EXCLUSIVE_RS_M         mask(20, 16)
+
+/// Number of bits to shift for [ordered] in a load/store exclusive instruction.
+#define LOAD_STORE_EXCLUSIVE_O0_S         15
+
+/// Mask for [ordered] in a load/store exclusive instruction.
+#define LOAD_STORE_EXCLUSIVE_O0_M         mask(15, 15)
+
+/// The [rs] of a load exclusive, which has no status register.
+#define LOAD_STORE_EXCLUSIVE_NO_RS        0x1F
+
 /// The intermediate representation of a load/store instruction.
 typedef struct {
 
@@ -130,6 +157,9 @@ typedef struct {
         /// Load literal.
         LOAD_LITERAL,
 
+        /// Load/store exclusive.
+        LOAD_STORE_EXCLUSIVE,
+
     } type;
 
     /// [19b] The constants for the load/store instruction group.
@@ -201,6 +231,23 @@ typedef struct {
         /// [19b] Load literal interpretation (signed immediate value).
         Literal simm19;
 
+        /// [12b] Load/store exclusive interpretation.
+        struct Exclusive {
+
+            /// [1b] Determines the type of data transfer: 0 for store, 1 for load.
+            bool l;
+
+            /// [1b] Whether the access is also ordered, i.e., \code ldaxr \endcode or \code stlxr \endcode
+            bool ordered;
+
+            /// [5b] The encoding of the Ws register, which a store exclusive sets to 0 if it succeeded, or else 1.
+            uint8_t rs;
+
+            /// [5b] The encoding of the Xn register, holding the (aligned) transfer address.
+            uint8_t xn;
+
+        } exclusive;
+
     } data;
 
     /// [5b] The encoding of the Rt register.
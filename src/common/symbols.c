@@ -0,0 +1,158 @@
+///
+/// symbols.c
+/// The labels and source lines of an assembled program, saved beside its binary so that it can be profiled.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "symbols.h"
+
+static void *grow(void *list, size_t *maxCount, size_t count, size_t size);
+
+/// Creates an empty set of symbols.
+/// @param source The path of the assembly the program is assembled from.
+/// @returns The symbols, to be freed by [freeSymbols].
+Symbols createSymbols(const char *source) {
+    Symbols symbols = calloc(1, sizeof(Symbols_s));
+    assertFatalNotNull(symbols, "<Symbols> Unable to allocate [Symbols_s]!");
+
+    symbols->source = strdup(source);
+    assertFatalNotNull(symbols->source, "<Memory> Unable to duplicate [char *]!");
+    return symbols;
+}
+
+/// Adds a label, keeping [labels] in order of address.
+/// @param symbols The symbols.
+/// @param name The name of the label, which is copied.
+/// @param address The address the label points to.
+void addSymbolLabel(Symbols symbols, const char *name, BitData address) {
+    symbols->labels = grow(symbols->labels, &symbols->labelMaxCount, symbols->labelCount, sizeof(struct SymbolLabel));
+
+    size_t i = symbols->labelCount++;
+    for (; i > 0 && symbols->labels[i - 1].address > address; i--) symbols->labels[i] = symbols->labels[i - 1];
+
+    symbols->labels[i].address = address;
+    symbols->labels[i].name = strdup(name);
+    assertFatalNotNull(symbols->labels[i].name, "<Memory> Unable to duplicate [char *]!");
+}
+
+/// Adds the source line of an instruction, keeping [lines] in order of address.
+/// @param symbols The symbols.
+/// @param address The address of the instruction.
+/// @param number The line it was assembled from, counting from 1.
+void addSymbolLine(Symbols symbols, BitData address, size_t number) {
+    symbols->lines = grow(symbols->lines, &symbols->lineMaxCount, symbols->lineCount, sizeof(struct SymbolLine));
+
+    size_t i = symbols->lineCount++;
+    for (; i > 0 && symbols->lines[i - 1].address > address; i--) symbols->lines[i] = symbols->lines[i - 1];
+
+    symbols->lines[i] = (struct SymbolLine) { .address = address, .number = number };
+}
+
+/// Saves symbols to a file, to be read back by [loadSymbols].
+/// @param symbols The symbols.
+/// @param path The path of the file.
+void saveSymbols(Symbols symbols, const char *path) {
+    FILE *file = fopen(path, "w");
+    assertFatalNotNullWithArgs(file, "Unable to open symbol file '%s'!", path);
+
+    fprintf(file, "source %s\n", symbols->source);
+    for (size_t i = 0; i < symbols->labelCount; i++) {
+        fprintf(file, "label 0x%" PRIx64 " %s\n", symbols->labels[i].address, symbols->labels[i].name);
+    }
+    for (size_t i = 0; i < symbols->lineCount; i++) {
+        fprintf(file, "line 0x%" PRIx64 " %zu\n", symbols->lines[i].address, symbols->lines[i].number);
+    }
+
+    assertFatal(fclose(file) == 0, "Unable to write symbol file!");
+}
+
+/// Loads symbols saved by [saveSymbols].
+/// @param path The path of the file.
+/// @returns The symbols, to be freed by [freeSymbols].
+Symbols loadSymbols(const char *path) {
+    FILE *file = fopen(path, "r");
+    assertFatalNotNullWithArgs(file, "Unable to open symbol file '%s'!", path);
+
+    char line[MAX_SYMBOL_LENGTH + 64];
+    char text[MAX_SYMBOL_LENGTH + 1];
+    assertFatalWithArgs(fgets(line, sizeof(line), file) != NULL && sscanf(line, "source %256s", text) == 1,
+                        "Symbol file '%s' does not name its source!", path);
+    Symbols symbols = createSymbols(text);
+
+    BitData address;
+    size_t number;
+    for (size_t lineNumber = 2; fgets(line, sizeof(line), file) != NULL; lineNumber++) {
+        if (sscanf(line, "label %" SCNx64 " %256s", &address, text) == 2) {
+            addSymbolLabel(symbols, text, address);
+        } else if (sscanf(line, "line %" SCNx64 " %zu", &address, &number) == 2) {
+            addSymbolLine(symbols, address, number);
+        } else {
+            throwFatalWithArgs("Invalid entry on line %zu of symbol file '%s'!", lineNumber, path);
+        }
+    }
+
+    fclose(file);
+    return symbols;
+}
+
+/// Finds the label an address falls under, i.e., the last at or before it.
+/// @param symbols The symbols.
+/// @param address The address.
+/// @returns The label, or NULL if [address] is before every label.
+const struct SymbolLabel *findLabel(Symbols symbols, BitData address) {
+    size_t low = 0, high = symbols->labelCount;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (symbols->labels[middle].address <= address) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low == 0 ? NULL : &symbols->labels[low - 1];
+}
+
+/// Finds the source line of the instruction at an address.
+/// @param symbols The symbols.
+/// @param address The address of the instruction.
+/// @returns The line, or NULL if no instruction was assembled to [address].
+const struct SymbolLine *findLine(Symbols symbols, BitData address) {
+    size_t low = 0, high = symbols->lineCount;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (symbols->lines[middle].address < address) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low < symbols->lineCount && symbols->lines[low].address == address ? &symbols->lines[low] : NULL;
+}
+
+/// Frees the given symbols.
+/// @param symbols The symbols.
+void freeSymbols(Symbols symbols) {
+    for (size_t i = 0; i < symbols->labelCount; i++) free(symbols->labels[i].name);
+    free(symbols->labels);
+    free(symbols->lines);
+    free(symbols->source);
+    free(symbols);
+}
+
+/// Makes room for one more element at the end of a list, doubling it if it is full.
+/// @param list The list, or NULL if none has been allocated.
+/// @param maxCount The number of elements [list] is allocated for, updated if it grows.
+/// @param count The number of elements in [list].
+/// @param size The size of an element.
+/// @returns The list, which may have moved.
+static void *grow(void *list, size_t *maxCount, size_t count, size_t size) {
+    if (count < *maxCount) return list;
+
+    *maxCount = *maxCount == 0 ? INITIAL_SYMBOLS_SIZE : *maxCount * 2;
+    list = realloc(list, *maxCount * size);
+    assertFatalNotNull(list, "<Symbols> Unable to grow list!");
+    return list;
+}
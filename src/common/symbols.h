@@ -0,0 +1,85 @@
+///
+/// symbols.h
+/// The labels and source lines of an assembled program, saved beside its binary so that it can be profiled.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef COMMON_SYMBOLS_H
+#define COMMON_SYMBOLS_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "const.h"
+#include "error.h"
+
+/// The initial number of labels, and of lines, a [Symbols] is allocated for.
+#define INITIAL_SYMBOLS_SIZE 64
+
+/// The longest label, or source path, read from a symbol file.
+#define MAX_SYMBOL_LENGTH    256
+
+/// The labels and source lines of an assembled program.
+/// @remark Saved as text, one entry per line: \code source <path> \endcode once, then
+/// \code label <address> <name> \endcode and \code line <address> <number> \endcode in order of address.
+typedef struct {
+    /// The path of the assembly the program was assembled from.
+    char *source;
+
+    /// The labels, in order of address.
+    struct SymbolLabel {
+        /// The address the label points to.
+        BitData address;
+
+        /// The name of the label.
+        char *name;
+    } *labels;
+
+    /// The number of [labels].
+    size_t labelCount;
+
+    /// The number of [labels] allocated for.
+    size_t labelMaxCount;
+
+    /// The source line of each instruction, in order of address.
+    struct SymbolLine {
+        /// The address of the instruction.
+        BitData address;
+
+        /// The line it was assembled from, counting from 1.
+        size_t number;
+    } *lines;
+
+    /// The number of [lines].
+    size_t lineCount;
+
+    /// The number of [lines] allocated for.
+    size_t lineMaxCount;
+} Symbols_s;
+
+/// Type definition of a pointer to [Symbols_s].
+typedef Symbols_s *Symbols;
+
+Symbols createSymbols(const char *source);
+
+void addSymbolLabel(Symbols symbols, const char *name, BitData address);
+
+void addSymbolLine(Symbols symbols, BitData address, size_t number);
+
+void saveSymbols(Symbols symbols, const char *path);
+
+Symbols loadSymbols(const char *path);
+
+const struct SymbolLabel *findLabel(Symbols symbols, BitData address);
+
+const struct SymbolLine *findLine(Symbols symbols, BitData address);
+
+void freeSymbols(Symbols symbols);
+
+#endif // COMMON_SYMBOLS_H
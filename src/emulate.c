@@ -7,33 +7,410 @@
 
 #include "emulate.h"
 
+/// The long options accepted by the emulator, ahead of its positional arguments.
+static const struct option options[] = {
+    { "engine",      required_argument, NULL, 'e' },
+    { "aot",         required_argument, NULL, 'a' },
+    { "fast-memory", no_argument,       NULL, 'f' },
+    { "gpio",        required_argument, NULL, 'g' },
+    { "uart",        required_argument, NULL, 'u' },
+    { "stats",       no_argument,       NULL, 's' },
+    { "max-instructions", required_argument, NULL, 'm' },
+    { "batch",       required_argument, NULL, 'b' },
+    { "threads",     required_argument, NULL, 't' },
+    { "cores",       required_argument, NULL, 'c' },
+    { "entry",       required_argument, NULL, 'p' },
+    { "round-robin", optional_argument, NULL, 'r' },
+    { "snapshot-at", required_argument, NULL, 'n' },
+    { "snapshot",    required_argument, NULL, 'o' },
+    { "restore",     required_argument, NULL, 'l' },
+    { "trace",       required_argument, NULL, 'x' },
+    { "profile",     optional_argument, NULL, 'i' },
+    { "symbols",     required_argument, NULL, 'y' },
+    { "folded",      required_argument, NULL, 'd' },
+    { "plugin",      required_argument, NULL, 'k' },
+    { NULL, 0, NULL, 0 }
+};
+
 int main(int argc, char **argv) {
+    Engine engine = BLOCK_ENGINE;
+    char *translationPath = NULL;
+    MemoryMode memoryMode = PAGED_MEMORY;
+    char *gpioPath = NULL;
+    char *uartPath = NULL;
+    bool stats = false;
+    uint64_t maxInstructions = UINT64_MAX;
+    char *batchPath = NULL;
+    size_t threads = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t coreCount = 0;
+    char *entryList = NULL;
+    uint64_t quantum = 0;
+    uint64_t snapshotAt = 0;
+    char *snapshotPath = NULL;
+    char *restorePath = NULL;
+    char *tracePath = NULL;
+    bool profiling = false;
+    char *profilePath = NULL;
+    char *symbolsPath = NULL;
+    char *foldedPath = NULL;
+    char *pluginPaths[MAX_PLUGINS];
+    size_t pluginCount = 0;
+
+    int option;
+    while ((option = getopt_long(argc, argv, "", options, NULL)) != -1) {
+        switch (option) {
+            case 'e':
+                if (strcmp(optarg, "reference") == 0) {
+                    engine = REFERENCE_ENGINE;
+                } else if (strcmp(optarg, "block") == 0) {
+                    engine = BLOCK_ENGINE;
+                } else if (strcmp(optarg, "threaded") == 0) {
+                    engine = THREADED_ENGINE;
+                } else if (strcmp(optarg, "jit") == 0) {
+                    engine = JIT_ENGINE;
+                } else {
+                    fprintf(stderr, "Unknown engine '%s'; expected 'reference', 'block', 'threaded' or 'jit'.\n",
+                            optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+
+            case 'a':
+                translationPath = optarg;
+                break;
+
+            case 'f':
+                memoryMode = FAST_MEMORY;
+                break;
+
+            case 'g':
+                gpioPath = optarg;
+                break;
+
+            case 'u':
+                uartPath = optarg;
+                break;
+
+            case 's':
+                stats = true;
+                break;
+
+            case 'm': {
+                char *end;
+                errno = 0;
+                maxInstructions = strtoull(optarg, &end, 10);
+                if (errno != 0 || end == optarg || *end != '\0' || optarg[0] == '-') {
+                    fprintf(stderr, "Invalid instruction budget '%s'; expected a non-negative integer.\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            }
+
+            case 'b':
+                batchPath = optarg;
+                break;
+
+            case 't': {
+                char *end;
+                unsigned long count = strtoul(optarg, &end, 10);
+                if (end == optarg || *end != '\0' || count == 0 || optarg[0] == '-') {
+                    fprintf(stderr, "Invalid thread count '%s'; expected a positive integer.\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                threads = count;
+                break;
+            }
+
+            case 'c': {
+                char *end;
+                unsigned long count = strtoul(optarg, &end, 10);
+                if (end == optarg || *end != '\0' || count == 0 || count > MAX_CORES || optarg[0] == '-') {
+                    fprintf(stderr, "Invalid core count '%s'; expected between 1 and %d.\n", optarg, MAX_CORES);
+                    return EXIT_FAILURE;
+                }
+                coreCount = count;
+                break;
+            }
+
+            case 'p':
+                entryList = optarg;
+                break;
+
+            case 'r': {
+                quantum = DEFAULT_CORE_QUANTUM;
+                if (optarg == NULL) break;
+
+                char *end;
+                errno = 0;
+                quantum = strtoull(optarg, &end, 10);
+                if (errno != 0 || end == optarg || *end != '\0' || quantum == 0 || optarg[0] == '-') {
+                    fprintf(stderr, "Invalid quantum '%s'; expected a positive integer.\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            }
+
+            case 'n': {
+                char *end;
+                errno = 0;
+                snapshotAt = strtoull(optarg, &end, 10);
+                if (errno != 0 || end == optarg || *end != '\0' || optarg[0] == '-') {
+                    fprintf(stderr, "Invalid snapshot point '%s'; expected a non-negative integer.\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            }
+
+            case 'o':
+                snapshotPath = optarg;
+                break;
+
+            case 'l':
+                restorePath = optarg;
+                break;
+
+            case 'x':
+                tracePath = optarg;
+                break;
+
+            case 'i':
+                profiling = true;
+                profilePath = optarg;
+                break;
+
+            case 'y':
+                symbolsPath = optarg;
+                break;
+
+            case 'd':
+                profiling = true;
+                foldedPath = optarg;
+                break;
+
+            case 'k':
+                if (pluginCount == MAX_PLUGINS) {
+                    fprintf(stderr, "At most %d plugins can be loaded.\n", MAX_PLUGINS);
+                    return EXIT_FAILURE;
+                }
+                pluginPaths[pluginCount++] = optarg;
+                break;
+
+            default:
+                return EXIT_FAILURE;
+        }
+    }
+
+    // Run every binary in the manifest, each dumping to its own output file.
+    if (batchPath != NULL) {
+        if (optind != argc) return EXIT_FAILURE;
+
+        Batch batch = loadBatch(batchPath, engine, memoryMode, maxInstructions);
+        size_t failures = runBatch(batch, threads);
+        freeBatch(batch);
+        return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Check that the positional arguments are valid, i.e., an input and optional output file.
+    int positional = argc - optind;
+    if (positional < 1 || positional > 2) return EXIT_FAILURE;
+
+    // Each core starts at its own entry point, if given; there is one core per entry point unless told otherwise.
+    BitData entries[MAX_CORES];
+    size_t entryCount = 0;
+    if (entryList != NULL) {
+        for (char *rest = entryList, *end; ; rest = end + 1) {
+            errno = 0;
+            BitData entry = strtoull(rest, &end, 0);
+            if (errno != 0 || end == rest || (*end != ',' && *end != '\0') || rest[0] == '-'
+                || entryCount == MAX_CORES) {
+                fprintf(stderr, "Invalid entry points '%s'; expected up to %d comma-separated addresses.\n",
+                        entryList, MAX_CORES);
+                return EXIT_FAILURE;
+            }
+
+            entries[entryCount++] = entry;
+            if (*end == '\0') break;
+        }
+
+        if (coreCount == 0) coreCount = entryCount;
+        if (entryCount != coreCount) {
+            fprintf(stderr, "Expected an entry point for each of the %zu cores.\n", coreCount);
+            return EXIT_FAILURE;
+        }
+    }
+    if (coreCount == 0) coreCount = 1;
+
+    // A snapshot is of a single core, taken once it has run [snapshotAt] instructions in all.
+    if ((snapshotPath != NULL || restorePath != NULL) && coreCount > 1) {
+        fprintf(stderr, "Snapshots can only be taken of, or restored to, a single core.\n");
+        return EXIT_FAILURE;
+    }
 
-    // Check that [argv] is valid, i.e., has 2-3 args.
-    if (argc < 2 || argc > 3) return EXIT_FAILURE;
+    if (tracePath != NULL && coreCount > 1) {
+        fprintf(stderr, "Only a single core can be traced.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (profiling && coreCount > 1) {
+        fprintf(stderr, "Only a single core can be profiled.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (pluginCount > 0 && coreCount > 1) {
+        fprintf(stderr, "Plugins can only be loaded for a single core.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (snapshotAt != 0 && snapshotPath == NULL) {
+        fprintf(stderr, "Expected a file to save the snapshot to, with --snapshot.\n");
+        return EXIT_FAILURE;
+    }
+
+    // Cores running at once share the one host window of fast memory.
+    if (coreCount > 1 && quantum == 0) memoryMode = FAST_MEMORY;
+
+    // Initialise memory; each core has its own registers.
+    Memory memory = allocMemFromFile(argv[optind], memoryMode);
+
+    // Translate the binary to C instead of running it.
+    if (translationPath != NULL) {
+        FILE *translationOut = fopen(translationPath, "w");
+        assertFatalNotNull(translationOut, "Unable to open translation output file!");
+
+        translateBinary(memory, argv[optind], translationOut);
+        fclose(translationOut);
+        freeMem(memory);
+        return EXIT_SUCCESS;
+    }
+
+    // Attach the requested peripherals, logging to or transmitting to their files.
+    FILE *gpioOut = NULL;
+    if (gpioPath != NULL) {
+        gpioOut = fopen(gpioPath, "w");
+        assertFatalNotNull(gpioOut, "Unable to open GPIO log file!");
+        attachDevice(&memory->bus, createGpio(gpioOut));
+    }
+
+    FILE *uartOut = NULL;
+    if (uartPath != NULL) {
+        uartOut = fopen(uartPath, "w");
+        assertFatalNotNull(uartOut, "Unable to open UART output file!");
+        attachDevice(&memory->bus, createUart(uartOut));
+    }
+
+    // Fetch, decode, execute, a basic block at a time, until every core has terminated or used up its budget.
+    Machine machine = createMachine(memory, coreCount, entryList != NULL ? entries : NULL, engine, maxInstructions);
+    Core *first = &machine->cores[0];
 
-    // Initialise registers and memory.
-    Registers_s registersStruct = createRegs();
-    Registers registers = &registersStruct;
-    Memory memory = allocMemFromFile(argv[1]);
+    // Resume from where a snapshot was taken, rather than from the start.
+    if (restorePath != NULL) {
+        Snapshot snapshot = loadSnapshot(restorePath);
+        restoreSnapshot(snapshot, &first->registers, memory);
+        freeSnapshot(snapshot);
+    }
+
+    // Run up to the snapshot point, and save the snapshot, before running on as usual.
+    if (snapshotPath != NULL) {
+        uint64_t until = snapshotAt < maxInstructions ? snapshotAt : maxInstructions;
+        uint64_t done = first->registers.instructions;
+        StopReason reason = done < until ? runFor(&first->registers, memory, engine, until - done) : STOP_BUDGET;
+
+        if (reason == STOP_FAULT) {
+            first->reason = STOP_FAULT;
+            strcpy(first->error, fatalError);
+        } else if (first->registers.instructions == snapshotAt) {
+            Snapshot snapshot = takeSnapshot(&first->registers, memory);
+            saveSnapshot(snapshot, snapshotPath);
+            freeSnapshot(snapshot);
+        } else {
+            fprintf(stderr, "No snapshot taken, as the program stopped after %" PRIu64 " instructions.\n",
+                    first->registers.instructions);
+        }
+    }
+
+    if (first->reason != STOP_FAULT) {
+        // Record, count, and analyse every instruction from here on, through the hooks of the memory they run over.
+        Symbols symbols = symbolsPath != NULL ? loadSymbols(symbolsPath) : NULL;
+        Trace trace = tracePath != NULL ? openTrace(tracePath, &first->registers, memory) : NULL;
+        Profile profile = profiling ? startProfile(memory) : NULL;
+
+        Plugin plugins[MAX_PLUGINS];
+        for (size_t i = 0; i < pluginCount; i++) plugins[i] = loadPlugin(pluginPaths[i], memory);
+
+        runMachine(machine, quantum);
+
+        for (size_t i = 0; i < pluginCount; i++) unloadPlugin(plugins[i], first->reason);
+        if (trace != NULL) closeTrace(trace, first->reason);
+        if (profile != NULL) {
+            stopProfile(profile);
+
+            FILE *profileOut = profilePath != NULL ? fopen(profilePath, "w") : stderr;
+            assertFatalNotNull(profileOut, "Unable to open profile output file!");
+            writeProfile(profile, symbols, profileOut);
+            if (profileOut != stderr) fclose(profileOut);
 
-    // Fetch first instruction
-    Instruction instruction = readMem(memory, false, getRegPC(registers));
+            if (foldedPath != NULL) {
+                FILE *foldedOut = fopen(foldedPath, "w");
+                assertFatalNotNull(foldedOut, "Unable to open folded stacks output file!");
+                writeFoldedStacks(profile, symbols, foldedOut);
+                fclose(foldedOut);
+            }
 
-    // Fetch, decode, execute cycle while the program has not terminated
-    while (instruction != HALT) {
-        execute(&instruction, registers, memory);
+            freeProfile(profile);
+        }
+        if (symbols != NULL) freeSymbols(symbols);
     }
 
-    // Dump contents of register and memory, then free memory.
+    // Each core is named in what is reported about it, only if there is more than one.
+    bool faulted = false;
+    bool halted = true;
+    for (size_t i = 0; i < coreCount; i++) {
+        Core *core = &machine->cores[i];
+        if (core->reason == STOP_FAULT) {
+            fprintf(stderr, "[FATAL]: ");
+            if (coreCount > 1) fprintf(stderr, "Core %zu: ", i);
+            fprintf(stderr, "%s\n", core->error);
+        }
+        faulted |= core->reason == STOP_FAULT;
+        halted &= core->reason == STOP_HALTED;
+    }
+
+    if (faulted) {
+        freeMachine(machine);
+        freeMem(memory);
+        if (gpioOut != NULL) fclose(gpioOut);
+        if (uartOut != NULL) fclose(uartOut);
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 0; i < coreCount; i++) {
+        Registers registers = &machine->cores[i].registers;
+        if (machine->cores[i].reason == STOP_BUDGET) {
+            if (coreCount > 1) fprintf(stderr, "Core %zu: ", i);
+            fprintf(stderr, "Stopped after %" PRIu64 " instructions, without halting.\n", registers->instructions);
+        }
+
+        if (stats) {
+            if (coreCount > 1) fprintf(stderr, "Core %zu: ", i);
+            fprintf(stderr, "Instructions executed: %" PRIu64 "\n", registers->instructions);
+        }
+    }
+
+    // Dump contents of every core's registers and the memory they share, then free memory.
     FILE *fileOut = stdout;
-    if (argc == 3) fileOut = fopen(argv[2], "w");
+    if (positional == 2) fileOut = fopen(argv[optind + 1], "w");
 
-    dumpRegs(registers, fileOut);
+    for (size_t i = 0; i < coreCount; i++) {
+        if (coreCount > 1) fprintf(fileOut, "Core %zu:\n", i);
+        dumpRegs(&machine->cores[i].registers, fileOut);
+    }
     dumpMem(memory, fileOut);
+    freeMachine(machine);
     freeMem(memory);
 
     fclose(fileOut);
+    if (gpioOut != NULL) fclose(gpioOut);
+    if (uartOut != NULL) fclose(uartOut);
 
-    return EXIT_SUCCESS;
+    return halted ? EXIT_SUCCESS : EXIT_FAILURE;
 }
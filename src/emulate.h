@@ -8,18 +8,26 @@
 #ifndef EMULATE_H
 #define EMULATE_H
 
+#include <getopt.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "batch.h"
+#include "bus.h"
+#include "cores.h"
 #include "emulatorDelegate.h"
+#include "gpio.h"
 #include "ir.h"
 #include "memory.h"
 #include "output.h"
+#include "plugin.h"
+#include "profile.h"
 #include "registers.h"
-
-#define HALT 0x8a000000
-
-bool JUMP_ON_ERROR = false;
-jmp_buf fatalBuffer;
-char *fatalError;
+#include "snapshot.h"
+#include "symbols.h"
+#include "trace.h"
+#include "translator.h"
+#include "uart.h"
 
 #endif //EMULATE_H
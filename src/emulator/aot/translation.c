@@ -0,0 +1,43 @@
+///
+/// translation.c
+/// The runtime that programs translated ahead-of-time to C are linked against.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "translation.h"
+
+/// Runs the program in [memory] to completion, using [translation] wherever it applies.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @param translation The translated program.
+/// @param instructions The instructions [translation] was translated from.
+/// @param count The number of [instructions].
+/// @remark Addresses [translation] does not cover (e.g., unresolved \code br \endcode targets) are stepped
+/// by the interpreter. If the loaded binary is not the one translated, or it modifies its own translated code,
+/// the rest of the run is left to the interpreter entirely.
+void runTranslation(Registers registers, Memory memory, Translation translation,
+                    const TranslatedInstruction *instructions, size_t count) {
+    // Decode every translated instruction into the cache, so that any store to one is noticed.
+    for (size_t i = 0; i < count; i++) {
+        Instruction instruction = readMem(memory, false, instructions[i].address);
+        if (instruction != instructions[i].instruction) {
+            run(registers, memory, BLOCK_ENGINE);
+            return;
+        }
+        cacheIR(memory, instructions[i].address, getDecodeFunction(instruction)(instruction));
+    }
+
+    uint64_t codeVersion = memory->codeVersion;
+    while (memory->codeVersion == codeVersion) {
+        if (translation(registers, memory, codeVersion)) return;
+
+        // Step the untranslated instruction, after which the translation may apply again.
+        Instruction instruction = readMem(memory, false, getRegPC(registers));
+        if (instruction == HALT) return;
+        execute(&instruction, registers, memory);
+    }
+
+    // The translation no longer describes the program in memory.
+    run(registers, memory, BLOCK_ENGINE);
+}
@@ -0,0 +1,37 @@
+///
+/// translation.h
+/// The runtime that programs translated ahead-of-time to C are linked against.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_TRANSLATION_H
+#define EMULATOR_TRANSLATION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "const.h"
+#include "emulatorDelegate.h"
+#include "memory.h"
+#include "registers.h"
+
+/// A program translated to C, run from the current PC.
+/// @returns Whether the program halted; false if execution reached an untranslated address, or a store changed
+/// decoded code, with the PC left at the next instruction to execute.
+typedef bool (*Translation)(Registers registers, Memory memory, uint64_t codeVersion);
+
+/// An instruction covered by a [Translation], as it was when translated.
+typedef struct {
+    /// The address of the instruction.
+    BitData address;
+
+    /// The binary instruction.
+    Instruction instruction;
+} TranslatedInstruction;
+
+void runTranslation(Registers registers, Memory memory, Translation translation,
+                    const TranslatedInstruction *instructions, size_t count);
+
+#endif // EMULATOR_TRANSLATION_H
@@ -0,0 +1,476 @@
+///
+/// translator.c
+/// Ahead-of-time translation of the reachable code of a binary into C.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "translator.h"
+
+/// The number of instruction slots in the virtual memory.
+#define TRANSLATOR_SLOTS (LOW_MEMORY_SIZE / WORD_SIZE)
+
+/// What is known about the instruction at each address while translating.
+typedef struct {
+    /// Whether the instruction is reachable from the entry point.
+    bool *reachable;
+
+    /// Whether the instruction may be jumped to, i.e., needs a label.
+    bool *leader;
+
+    /// Whether the instruction could be decoded; those which cannot are left to the interpreter.
+    bool *decodable;
+
+    /// The decoded instructions.
+    IR *irs;
+} Translator;
+
+static void discover(Translator *translator, Memory memory);
+
+static bool tryDecode(Instruction instruction, IR *ir);
+
+static void emitInstruction(Translator *translator, FILE *out, size_t slot, Instruction instruction);
+
+static void emitImmediate(FILE *out, Immediate_IR *ir);
+
+static void emitRegister(FILE *out, Register_IR *ir, size_t slot);
+
+static void emitBranch(Translator *translator, FILE *out, Branch_IR *ir, BitData address);
+
+static void emitJump(Translator *translator, FILE *out, BitData address, BitData target, const char *indent);
+
+static void emitExecutor(FILE *out, const char *executor, size_t slot);
+
+static void emitArithmeticFlags(FILE *out, bool sf, bool subtract);
+
+static const char *readReg(char buffer[static 32], uint8_t id, bool sf);
+
+static void emitWriteReg(FILE *out, uint8_t id, bool sf, const char *value);
+
+/// Translates the code reachable from address 0 of [memory] into a C program, which runs the translated code
+/// where it can, and the interpreter everywhere else.
+/// @param memory The virtual memory, loaded with the binary to translate.
+/// @param binaryPath The path to the binary, for the generated file's header.
+/// @param out The file to write the C program to.
+void translateBinary(Memory memory, const char *binaryPath, FILE *out) {
+    Translator translator = {
+        .reachable = calloc(TRANSLATOR_SLOTS, sizeof(bool)),
+        .leader = calloc(TRANSLATOR_SLOTS, sizeof(bool)),
+        .decodable = calloc(TRANSLATOR_SLOTS, sizeof(bool)),
+        .irs = calloc(TRANSLATOR_SLOTS, sizeof(IR)),
+    };
+    assertFatal(translator.reachable != NULL && translator.leader != NULL
+                && translator.decodable != NULL && translator.irs != NULL,
+                "<Translator> Unable to allocate translation state!");
+
+    discover(&translator, memory);
+
+    bool dispatches = false;
+    for (size_t slot = 0; slot < TRANSLATOR_SLOTS; slot++) {
+        IR *ir = &translator.irs[slot];
+        if (translator.decodable[slot] && ir->type == BRANCH && ir->ir.branchIR.type == BRANCH_REGISTER) {
+            dispatches = true;
+        }
+    }
+
+    fprintf(out, "///\n/// Translated from %s by `emulate --aot`.\n///\n\n", binaryPath);
+    fprintf(out, "#include \"emulate.h\"\n#include \"translation.h\"\n\n");
+
+    // Every reachable instruction, so that the runtime can check it is running the binary translated.
+    fprintf(out, "static const TranslatedInstruction instructions[] = {\n");
+    size_t count = 0;
+    for (size_t slot = 0; slot < TRANSLATOR_SLOTS; slot++) {
+        if (!translator.reachable[slot] || !translator.decodable[slot]) continue;
+        fprintf(out, "    { 0x%zx, 0x%08" PRIx32 " },\n", slot * WORD_SIZE,
+                (Instruction) readMem(memory, false, slot * WORD_SIZE));
+        count++;
+    }
+    if (count == 0) fprintf(out, "    { 0, 0 },\n");
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static bool translation(Registers registers, unused Memory memory, "
+                 "unused uint64_t codeVersion) {\n");
+    fprintf(out, "    BitData pc = getRegPC(registers);\n\n");
+    if (dispatches) fprintf(out, "dispatch:\n");
+    fprintf(out, "    switch (pc) {\n");
+    for (size_t slot = 0; slot < TRANSLATOR_SLOTS; slot++) {
+        if (translator.leader[slot]) fprintf(out, "        case 0x%zx: goto L_%zx;\n", slot * WORD_SIZE, slot);
+    }
+    fprintf(out, "        default:\n");
+    fprintf(out, "            setRegPC(registers, pc);\n");
+    fprintf(out, "            return false;\n");
+    fprintf(out, "    }\n");
+
+    for (size_t slot = 0; slot < TRANSLATOR_SLOTS; slot++) {
+        if (!translator.reachable[slot]) continue;
+
+        if (translator.leader[slot]) fprintf(out, "\nL_%zx:\n", slot);
+        emitInstruction(&translator, out, slot, readMem(memory, false, slot * WORD_SIZE));
+    }
+    fprintf(out, "}\n\n");
+
+    fprintf(out, "int main(int argc, char **argv) {\n");
+    fprintf(out, "    if (argc < 2 || argc > 3) return EXIT_FAILURE;\n\n");
+    fprintf(out, "    Registers_s registersStruct = createRegs();\n");
+    fprintf(out, "    Registers registers = &registersStruct;\n");
+    fprintf(out, "    Memory memory = allocMemFromFile(argv[1], PAGED_MEMORY);\n\n");
+    fprintf(out, "    runTranslation(registers, memory, translation, instructions, %zu);\n\n", count);
+    fprintf(out, "    FILE *fileOut = stdout;\n");
+    fprintf(out, "    if (argc == 3) fileOut = fopen(argv[2], \"w\");\n\n");
+    fprintf(out, "    dumpRegs(registers, fileOut);\n");
+    fprintf(out, "    dumpMem(memory, fileOut);\n");
+    fprintf(out, "    freeMem(memory);\n\n");
+    fprintf(out, "    fclose(fileOut);\n\n");
+    fprintf(out, "    return EXIT_SUCCESS;\n");
+    fprintf(out, "}\n");
+
+    free(translator.reachable);
+    free(translator.leader);
+    free(translator.decodable);
+    free(translator.irs);
+}
+
+/// Finds every instruction reachable from address 0 by following fall-throughs and direct branches.
+/// @param translator The translation state to fill in.
+/// @param memory The virtual memory, loaded with the binary to translate.
+/// @remark The targets of \code br \endcode are unknown until run-time, so are left to the interpreter.
+static void discover(Translator *translator, Memory memory) {
+    size_t *worklist = malloc(TRANSLATOR_SLOTS * sizeof(size_t));
+    assertFatalNotNull(worklist, "<Translator> Unable to allocate worklist!");
+
+    size_t pending = 0;
+    worklist[pending++] = 0;
+    translator->leader[0] = true;
+
+    while (pending > 0) {
+        for (size_t slot = worklist[--pending]; slot < TRANSLATOR_SLOTS; slot++) {
+            // Falling into code already discovered means it needs a label to jump to.
+            if (translator->reachable[slot]) {
+                translator->leader[slot] = true;
+                break;
+            }
+            translator->reachable[slot] = true;
+
+            Instruction instruction = readMem(memory, false, slot * WORD_SIZE);
+            if (instruction == HALT) {
+                translator->decodable[slot] = true;
+                break;
+            }
+
+            IR *ir = &translator->irs[slot];
+            translator->decodable[slot] = tryDecode(instruction, ir);
+            if (!translator->decodable[slot]) break;
+            if (ir->type != BRANCH) continue;
+
+            // Queue up direct branch targets, which are in range and not the branch itself.
+            Branch_IR *branchIR = &ir->ir.branchIR;
+            if (branchIR->type == BRANCH_REGISTER) break;
+
+            int64_t offset = branchIR->type == BRANCH_UNCONDITIONAL
+                             ? branchIR->data.simm26.data.immediate
+                             : branchIR->data.conditional.simm19.data.immediate;
+            size_t target = slot + offset;
+            if (offset != 0 && target < TRANSLATOR_SLOTS) {
+                translator->leader[target] = true;
+                if (!translator->reachable[target]) worklist[pending++] = target;
+            }
+
+            if (branchIR->type == BRANCH_UNCONDITIONAL && offset != 0) break;
+        }
+    }
+
+    free(worklist);
+}
+
+/// Decodes [instruction], without treating an undecodable instruction as fatal.
+/// @param instruction The binary instruction.
+/// @param ir Where to write the decoded instruction.
+/// @returns Whether [instruction] could be decoded.
+static bool tryDecode(Instruction instruction, IR *ir) {
+    JUMP_ON_ERROR = true;
+    if (setjmp(fatalBuffer)) {
+        JUMP_ON_ERROR = false;
+        return false;
+    }
+
+    *ir = getDecodeFunction(instruction)(instruction);
+    JUMP_ON_ERROR = false;
+    return true;
+}
+
+/// Emits the C for a single reachable instruction.
+/// @param translator The translation state.
+/// @param out The file to write to.
+/// @param slot The index of the instruction's word in the virtual memory.
+/// @param instruction The binary instruction.
+static void emitInstruction(Translator *translator, FILE *out, size_t slot, Instruction instruction) {
+    BitData address = slot * WORD_SIZE;
+    fprintf(out, "    // 0x%08" PRIx64 ": 0x%08" PRIx32 "\n", address, instruction);
+
+    // Let the interpreter raise the error for anything undecodable, at the point it would have.
+    if (!translator->decodable[slot]) {
+        fprintf(out, "    setRegPC(registers, 0x%" PRIx64 ");\n    return false;\n", address);
+        return;
+    }
+
+    if (instruction == HALT) {
+        fprintf(out, "    setRegPC(registers, 0x%" PRIx64 ");\n    return true;\n", address);
+        return;
+    }
+
+    fprintf(out, "    registers->instructions++;\n");
+
+    IR *ir = &translator->irs[slot];
+    switch (ir->type) {
+        case IMMEDIATE:
+            emitImmediate(out, &ir->ir.immediateIR);
+            break;
+
+        case REGISTER:
+            emitRegister(out, &ir->ir.registerIR, slot);
+            break;
+
+        case LOAD_STORE:
+            // Loads and stores need the PC (for literals), and may modify translated code.
+            fprintf(out, "    setRegPC(registers, 0x%" PRIx64 ");\n", address);
+            emitExecutor(out, "executeLoadStore", slot);
+            fprintf(out, "    if (memory->codeVersion != codeVersion) {\n");
+            fprintf(out, "        setRegPC(registers, 0x%" PRIx64 ");\n", address + WORD_SIZE);
+            fprintf(out, "        return false;\n");
+            fprintf(out, "    }\n");
+            break;
+
+        case BRANCH:
+            emitBranch(translator, out, &ir->ir.branchIR, address);
+            return;
+
+        case BARRIER:
+            // Translated programs run on a single core, over memory of their own.
+            fprintf(out, "    __atomic_thread_fence(__ATOMIC_SEQ_CST);\n");
+            break;
+
+        default:
+            throwFatal("<Translator> Invalid IR!");
+    }
+
+    // Leave the translation if execution falls through onto an untranslated address.
+    if (slot + 1 >= TRANSLATOR_SLOTS || !translator->reachable[slot + 1]) {
+        emitJump(translator, out, address, address + WORD_SIZE, "    ");
+    }
+}
+
+/// Emits the C for a data processing (immediate) instruction, following [executeImmediate].
+/// @param out The file to write to.
+/// @param ir The instruction.
+static void emitImmediate(FILE *out, Immediate_IR *ir) {
+    char buffer[32];
+
+    if (ir->opi == IMMEDIATE_ARITHMETIC) {
+        struct Arithmetic *operand = &ir->operand.arithmetic;
+        enum ArithmeticType type = ir->opc.arithmeticType;
+        bool subtract = type == SUB || type == SUBS;
+
+        fprintf(out, "    {\n");
+        fprintf(out, "        uint64_t rn = %s;\n", readReg(buffer, operand->rn, ir->sf));
+        fprintf(out, "        uint64_t op2 = 0x%" PRIx32 ";\n", (uint32_t) operand->imm12 << (operand->sh * 12));
+        fprintf(out, "        uint64_t res = rn %c op2;\n", subtract ? '-' : '+');
+        if (type == ADDS || type == SUBS) emitArithmeticFlags(out, ir->sf, subtract);
+        emitWriteReg(out, ir->rd, ir->sf, "res");
+        fprintf(out, "    }\n");
+        return;
+    }
+
+    struct WideMove *operand = &ir->operand.wideMove;
+    uint64_t op = (uint64_t) operand->imm16 << (operand->hw * 16);
+    char value[128];
+
+    switch (ir->opc.wideMoveType) {
+        case MOVN:
+            snprintf(value, sizeof(value), "0x%" PRIx64 "u", ~op);
+            break;
+
+        case MOVZ:
+            snprintf(value, sizeof(value), "0x%" PRIx64 "u", op);
+            break;
+
+        case MOVK:
+            snprintf(value, sizeof(value), "0x%" PRIx64 "u | (%s & 0x%" PRIx64 "u)",
+                     op, readReg(buffer, ir->rd, ir->sf), ~((uint64_t) UINT16_MAX << (operand->hw * 16)));
+            break;
+    }
+
+    fprintf(out, "    {\n");
+    emitWriteReg(out, ir->rd, ir->sf, value);
+    fprintf(out, "    }\n");
+}
+
+/// Emits the C for a data processing (register) instruction, following [executeRegister].
+/// @param out The file to write to.
+/// @param ir The instruction.
+/// @param slot The index of the instruction's word in the virtual memory.
+static void emitRegister(FILE *out, Register_IR *ir, size_t slot) {
+    char buffer[32];
+
+    if (ir->group == MULTIPLY) {
+        fprintf(out, "    {\n");
+        fprintf(out, "        uint64_t ra = %s;\n", readReg(buffer, ir->operand.multiply.ra, ir->sf));
+        fprintf(out, "        uint64_t rn = %s;\n", readReg(buffer, ir->rn, ir->sf));
+        fprintf(out, "        uint64_t rm = %s;\n", readReg(buffer, ir->rm, ir->sf));
+        emitWriteReg(out, ir->rd, ir->sf, ir->operand.multiply.x ? "ra - rn * rm" : "ra + rn * rm");
+        fprintf(out, "    }\n");
+        return;
+    }
+
+    // Reserved 32-bit shift amounts are left to the executor, whatever it makes of them.
+    uint8_t amount = ir->operand.imm6;
+    if (!ir->sf && amount >= 32) {
+        emitExecutor(out, "executeRegister", slot);
+        return;
+    }
+
+    unsigned width = ir->sf ? 64 : 32;
+    fprintf(out, "    {\n");
+    fprintf(out, "        uint64_t rn = %s;\n", readReg(buffer, ir->rn, ir->sf));
+    fprintf(out, "        uint64_t rm = %s;\n", readReg(buffer, ir->rm, ir->sf));
+    switch (ir->shift) {
+        case LSL:
+            fprintf(out, "        uint64_t op2 = rm << %u;\n", amount);
+            break;
+
+        case LSR:
+            fprintf(out, "        uint64_t op2 = rm >> %u;\n", amount);
+            break;
+
+        case ASR:
+            fprintf(out, "        uint64_t op2 = (uint64_t) ((int64_t) (int%u_t) rm >> %u);\n", width, amount);
+            break;
+
+        case ROR:
+            if (amount == 0) {
+                fprintf(out, "        uint64_t op2 = rm;\n");
+            } else {
+                fprintf(out, "        uint64_t op2 = (rm >> %u) | (rm << %u);\n", amount, width - amount);
+            }
+            break;
+    }
+    if (!ir->sf) fprintf(out, "        op2 = (uint32_t) op2;\n");
+
+    if (ir->group == ARITHMETIC) {
+        enum ArithmeticType type = ir->opc.arithmetic;
+        bool subtract = type == SUB || type == SUBS;
+
+        fprintf(out, "        uint64_t res = rn %c op2;\n", subtract ? '-' : '+');
+        if (type == ADDS || type == SUBS) emitArithmeticFlags(out, ir->sf, subtract);
+    } else {
+        // Standard and negated bit-logic opcodes share ordinals.
+        static const char *operators[] = { [AND] = "&", [ORR] = "|", [EOR] = "^", [ANDS] = "&" };
+        fprintf(out, "        uint64_t res = rn %s %sop2;\n", operators[ir->opc.logic.standard], ir->negated ? "~" : "");
+
+        if (ir->opc.logic.standard == ANDS) {
+            fprintf(out, "        registers->flags = (LazyFlags) { FLAGS_LOGIC, %s, rn, op2, res };\n",
+                    ir->sf ? "true" : "false");
+        }
+    }
+
+    emitWriteReg(out, ir->rd, ir->sf, "res");
+    fprintf(out, "    }\n");
+}
+
+/// Emits the C for a branch instruction, following [executeBranch].
+/// @param translator The translation state.
+/// @param out The file to write to.
+/// @param ir The instruction.
+/// @param address The address of the instruction.
+static void emitBranch(Translator *translator, FILE *out, Branch_IR *ir, BitData address) {
+    switch (ir->type) {
+        case BRANCH_UNCONDITIONAL:
+            emitJump(translator, out, address, address + 4 * (int64_t) ir->data.simm26.data.immediate, "    ");
+            break;
+
+        case BRANCH_REGISTER: {
+            char buffer[32];
+            fprintf(out, "    pc = %s;\n", readReg(buffer, ir->data.xn, true));
+            fprintf(out, "    if (pc == 0x%" PRIx64 ") pc += %zu;\n", address, WORD_SIZE);
+            fprintf(out, "    goto dispatch;\n");
+            break;
+        }
+
+        case BRANCH_CONDITIONAL: {
+            BitData target = address + 4 * (int64_t) ir->data.conditional.simm19.data.immediate;
+            fprintf(out, "    if (0x%04x >> getRegNZCV(registers) & 1) {\n",
+                    conditionTruthTable(ir->data.conditional.condition));
+            emitJump(translator, out, address, target, "        ");
+            fprintf(out, "    }\n");
+            emitJump(translator, out, address, address + WORD_SIZE, "    ");
+            break;
+        }
+    }
+}
+
+/// Emits a transfer of control from the instruction at [address] to [target].
+/// @param translator The translation state.
+/// @param out The file to write to.
+/// @param address The address of the instruction transferring control.
+/// @param target The address to continue from.
+/// @param indent The indentation to emit with.
+/// @remark As in [execute], a branch which leaves the PC where it was is treated as not having branched.
+static void emitJump(Translator *translator, FILE *out, BitData address, BitData target, const char *indent) {
+    if (target == address) target += WORD_SIZE;
+
+    // Fall through naturally where the target is emitted next.
+    size_t slot = target / WORD_SIZE;
+    if (target == address + WORD_SIZE && slot < TRANSLATOR_SLOTS && translator->reachable[slot]) return;
+
+    if (target % WORD_SIZE == 0 && slot < TRANSLATOR_SLOTS && translator->leader[slot]) {
+        fprintf(out, "%sgoto L_%zx;\n", indent, slot);
+    } else {
+        fprintf(out, "%ssetRegPC(registers, 0x%" PRIx64 ");\n%sreturn false;\n", indent, target, indent);
+    }
+}
+
+/// Emits a call to an interpreter executor, with the instruction's cached decoding.
+/// @param out The file to write to.
+/// @param executor The name of the executor to call.
+/// @param slot The index of the instruction's word in the virtual memory.
+/// @remark [runTranslation] caches the decoding of every translated instruction, and the translation is left as
+/// soon as any of them is overwritten, so the cached decoding is always valid.
+static void emitExecutor(FILE *out, const char *executor, size_t slot) {
+    fprintf(out, "    %s(getCachedIR(memory, 0x%zx), registers, memory);\n", executor, slot * WORD_SIZE);
+}
+
+/// Emits the (lazy) NZCV update of an arithmetic instruction, following [arithmeticExecute].
+/// @param out The file to write to.
+/// @param sf Whether the operation is 64-bit.
+/// @param subtract Whether the operation is a subtraction.
+static void emitArithmeticFlags(FILE *out, bool sf, bool subtract) {
+    fprintf(out, "        registers->flags = (LazyFlags) { %s, %s, rn, op2, res };\n",
+            subtract ? "FLAGS_SUB" : "FLAGS_ADD", sf ? "true" : "false");
+}
+
+/// Gets the C expression for reading register [id], as in [getReg].
+/// @param buffer Where to write the expression.
+/// @param id The register.
+/// @param sf Whether to read all 64 bits, rather than the bottom 32.
+/// @returns [buffer].
+static const char *readReg(char buffer[static 32], uint8_t id, bool sf) {
+    if (id == ZERO_REGISTER) {
+        snprintf(buffer, 32, "0");
+    } else {
+        snprintf(buffer, 32, "%sregisters->gprs[%u]", sf ? "" : "(uint32_t) ", id);
+    }
+    return buffer;
+}
+
+/// Emits the C for writing [value] to register [id], as in [setReg].
+/// @param out The file to write to.
+/// @param id The register.
+/// @param sf Whether to write all 64 bits, rather than zero-extending the bottom 32.
+/// @param value The C expression to write.
+static void emitWriteReg(FILE *out, uint8_t id, bool sf, const char *value) {
+    // Writes to the zero register are discarded.
+    if (id == ZERO_REGISTER) {
+        fprintf(out, "        (void) (%s);\n", value);
+        return;
+    }
+    fprintf(out, "        registers->gprs[%u] = %s(%s);\n", id, sf ? "" : "(uint32_t) ", value);
+}
@@ -0,0 +1,25 @@
+///
+/// translator.h
+/// Ahead-of-time translation of the reachable code of a binary into C.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_TRANSLATOR_H
+#define EMULATOR_TRANSLATOR_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "const.h"
+#include "emulatorDelegate.h"
+#include "error.h"
+#include "ir.h"
+#include "memory.h"
+
+void translateBinary(Memory memory, const char *binaryPath, FILE *out);
+
+#endif // EMULATOR_TRANSLATOR_H
@@ -0,0 +1,151 @@
+///
+/// batch.c
+/// Runs many binaries in one process, spread over a pool of host threads.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "batch.h"
+
+static void *runWorker(void *argument);
+
+static bool runJob(Batch batch, BatchJob *job);
+
+/// Reads a manifest of binaries to run, one per line as \code binary output \endcode
+/// @param path The path of the manifest.
+/// @param engine The engine to run every job with.
+/// @param memoryMode The backend of every job's virtual memory.
+/// @param maxInstructions The most instructions to run any one job for.
+/// @returns The batch of jobs, none of which have run yet.
+/// @remark Blank lines, and lines starting with \code # \endcode, are skipped.
+Batch loadBatch(const char *path, Engine engine, MemoryMode memoryMode, uint64_t maxInstructions) {
+    FILE *manifest = fopen(path, "r");
+    assertFatalNotNullWithArgs(manifest, "Unable to open batch manifest '%s'!", path);
+
+    Batch batch = calloc(1, sizeof(Batch_s));
+    assertFatalNotNull(batch, "<Batch> Unable to allocate [Batch_s]!");
+    batch->engine = engine;
+    batch->memoryMode = memoryMode;
+    batch->maxInstructions = maxInstructions;
+
+    size_t capacity = 0;
+    char *line = NULL;
+    size_t lineSize = 0;
+    for (size_t lineNumber = 1; getline(&line, &lineSize, manifest) != -1; lineNumber++) {
+        char *rest;
+        char *binary = strtok_r(line, WHITESPACE, &rest);
+        if (binary == NULL || binary[0] == '#') continue;
+
+        char *output = strtok_r(NULL, WHITESPACE, &rest);
+        assertFatalWithArgs(output != NULL && strtok_r(NULL, WHITESPACE, &rest) == NULL,
+                            "Line %zu of batch manifest should be a binary and an output file!", lineNumber);
+
+        if (batch->count == capacity) {
+            capacity = capacity == 0 ? 16 : capacity * 2;
+            batch->jobs = realloc(batch->jobs, capacity * sizeof(BatchJob));
+            assertFatalNotNull(batch->jobs, "<Batch> Unable to allocate [BatchJob]s!");
+        }
+
+        batch->jobs[batch->count++] = (BatchJob) { .binary = strdup(binary), .output = strdup(output) };
+    }
+
+    free(line);
+    fclose(manifest);
+    return batch;
+}
+
+/// Runs every job of [batch], each with its own registers and memory, on a pool of [threads] host threads.
+/// @param batch The batch of jobs.
+/// @param threads The number of threads to run jobs on.
+/// @returns The number of jobs which did not halt cleanly, i.e., which faulted or ran out of instructions.
+/// @remark Each job's final state is dumped to its output file exactly as a single run would; whatever stopped a
+/// job from halting is reported on stderr. Workers claim jobs one at a time, so long and short jobs balance out.
+size_t runBatch(Batch batch, size_t threads) {
+    if (threads > batch->count) threads = batch->count;
+    // Each worker holds at most one memory at a time.
+    if (batch->memoryMode == FAST_MEMORY && threads > MAX_FAST_MEMORIES) threads = MAX_FAST_MEMORIES;
+    if (threads == 0) return 0;
+
+    pthread_t *workers = malloc(threads * sizeof(pthread_t));
+    assertFatalNotNull(workers, "<Batch> Unable to allocate worker threads!");
+
+    for (size_t i = 0; i < threads; i++) {
+        assertFatal(pthread_create(&workers[i], NULL, runWorker, batch) == 0, "<Batch> Unable to start worker!");
+    }
+
+    for (size_t i = 0; i < threads; i++) pthread_join(workers[i], NULL);
+
+    free(workers);
+    return batch->failures;
+}
+
+/// Frees the given batch.
+/// @param batch The batch of jobs.
+void freeBatch(Batch batch) {
+    for (size_t i = 0; i < batch->count; i++) {
+        free(batch->jobs[i].binary);
+        free(batch->jobs[i].output);
+    }
+
+    free(batch->jobs);
+    free(batch);
+}
+
+/// Claims and runs jobs from the batch until there are none left.
+/// @param argument The [Batch].
+/// @returns NULL.
+static void *runWorker(void *argument) {
+    Batch batch = argument;
+
+    // Any job's error is caught and reported, rather than exiting every other job with it.
+    JUMP_ON_ERROR = true;
+
+    size_t index;
+    while ((index = __atomic_fetch_add(&batch->next, 1, __ATOMIC_RELAXED)) < batch->count) {
+        if (!runJob(batch, &batch->jobs[index])) __atomic_fetch_add(&batch->failures, 1, __ATOMIC_RELAXED);
+    }
+
+    return NULL;
+}
+
+/// Runs a single job to completion, and dumps its final state.
+/// @param batch The batch of jobs.
+/// @param job The job to run.
+/// @returns Whether the job halted cleanly.
+static bool runJob(Batch batch, BatchJob *job) {
+    // Loading the binary is all that may fail before [runFor] catches errors itself.
+    if (setjmp(fatalBuffer)) {
+        fprintf(stderr, "[FATAL] %s: %s\n", job->binary, fatalError);
+        return false;
+    }
+
+    Registers_s registersStruct = createRegs();
+    Registers registers = &registersStruct;
+    Memory memory = allocMemFromFile(job->binary, batch->memoryMode);
+
+    StopReason reason = runFor(registers, memory, batch->engine, batch->maxInstructions);
+    if (reason == STOP_FAULT) {
+        fprintf(stderr, "[FATAL] %s: %s\n", job->binary, fatalError);
+        freeMem(memory);
+        return false;
+    }
+
+    if (reason == STOP_BUDGET) {
+        fprintf(stderr, "%s: Stopped after %" PRIu64 " instructions, without halting.\n",
+                job->binary, registers->instructions);
+    }
+
+    FILE *fileOut = fopen(job->output, "w");
+    if (fileOut == NULL) {
+        fprintf(stderr, "[FATAL] %s: Unable to open output file '%s'!\n", job->binary, job->output);
+        freeMem(memory);
+        return false;
+    }
+
+    dumpRegs(registers, fileOut);
+    dumpMem(memory, fileOut);
+    fclose(fileOut);
+    freeMem(memory);
+
+    return reason == STOP_HALTED;
+}
@@ -0,0 +1,69 @@
+///
+/// batch.h
+/// Runs many binaries in one process, spread over a pool of host threads.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_BATCH_H
+#define EMULATOR_BATCH_H
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "const.h"
+#include "emulatorDelegate.h"
+#include "error.h"
+#include "memory.h"
+#include "output.h"
+#include "registers.h"
+
+/// One binary to run, and the file to dump its final state to.
+typedef struct {
+    /// The path of the binary.
+    char *binary;
+
+    /// The path of the dump.
+    char *output;
+} BatchJob;
+
+/// A manifest of [BatchJob]s, and how to run them.
+typedef struct {
+    /// The jobs, in manifest order.
+    BatchJob *jobs;
+
+    /// The number of [jobs].
+    size_t count;
+
+    /// The engine to run every job with.
+    Engine engine;
+
+    /// The backend of every job's virtual memory.
+    MemoryMode memoryMode;
+
+    /// The most instructions to run any one job for.
+    uint64_t maxInstructions;
+
+    /// The index of the next job to be claimed by a worker.
+    size_t next;
+
+    /// The number of jobs which did not halt cleanly.
+    size_t failures;
+} Batch_s;
+
+/// Type definition of a pointer to [Batch_s].
+typedef Batch_s *Batch;
+
+Batch loadBatch(const char *path, Engine engine, MemoryMode memoryMode, uint64_t maxInstructions);
+
+size_t runBatch(Batch batch, size_t threads);
+
+void freeBatch(Batch batch);
+
+#endif // EMULATOR_BATCH_H
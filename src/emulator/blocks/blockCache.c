@@ -0,0 +1,111 @@
+///
+/// blockCache.c
+/// Storage and lookup of decoded basic blocks, chained to their successors.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "blockCache.h"
+
+static size_t slotOf(BlockCache cache, BitData start);
+
+static void growBlockCache(BlockCache cache);
+
+/// Creates an empty block cache.
+/// @returns The new [BlockCache].
+BlockCache createBlockCache(void) {
+    BlockCache cache = malloc(sizeof(struct BlockCache_s));
+    assertFatalNotNull(cache, "<Memory> Unable to allocate [BlockCache]!");
+
+    cache->table = calloc(BLOCK_CACHE_INITIAL, sizeof(Block *));
+    assertFatalNotNull(cache->table, "<Memory> Unable to contiguously allocate [table]!");
+
+    cache->capacity = BLOCK_CACHE_INITIAL;
+    cache->count = 0;
+    cache->codeVersion = 0;
+    cache->code = NULL;
+    cache->codeUsed = 0;
+    return cache;
+}
+
+/// Frees the given block cache and every [Block] in it.
+/// @param cache The cache to free.
+void destroyBlockCache(BlockCache cache) {
+    flushBlockCache(cache);
+    if (cache->code != NULL) {
+        assertFatal(munmap(cache->code, NATIVE_REGION_SIZE) == 0, "<Memory> Unable to un-map compiled code!");
+    }
+    free(cache->table);
+    free(cache);
+}
+
+/// Frees every [Block] in the cache, leaving it empty.
+/// @param cache The cache to flush.
+/// @remark Chained [Block.taken] and [Block.fallthrough] links only ever point within the same cache,
+/// so no dangling links survive a flush. Likewise, compiled code is only reachable through its [Block], so the
+/// whole code region is reclaimed.
+void flushBlockCache(BlockCache cache) {
+    for (size_t i = 0; i < cache->capacity; i++) {
+        if (cache->table[i] != NULL) free(cache->table[i]->idle);
+        free(cache->table[i]);
+        cache->table[i] = NULL;
+    }
+    cache->count = 0;
+    cache->codeUsed = 0;
+}
+
+/// Finds the block starting at [start].
+/// @param cache The cache to search.
+/// @param start The address of the first instruction of the block.
+/// @returns The [Block], or NULL if none has been recorded.
+Block *findBlock(BlockCache cache, BitData start) {
+    for (size_t i = slotOf(cache, start); cache->table[i] != NULL; i = (i + 1) & (cache->capacity - 1)) {
+        if (cache->table[i]->start == start) return cache->table[i];
+    }
+    return NULL;
+}
+
+/// Inserts [block] into the cache, taking ownership of it.
+/// @param cache The cache to insert into.
+/// @param block The block to insert.
+/// @pre No block with the same [Block.start] is in the cache.
+void insertBlock(BlockCache cache, Block *block) {
+    // Keep the load factor at or below one half.
+    if (2 * (cache->count + 1) > cache->capacity) growBlockCache(cache);
+
+    size_t i = slotOf(cache, block->start);
+    while (cache->table[i] != NULL) i = (i + 1) & (cache->capacity - 1);
+
+    cache->table[i] = block;
+    cache->count++;
+}
+
+/// Gets the preferred slot of the block starting at [start].
+/// @param cache The cache to index into.
+/// @param start The address of the first instruction of the block.
+/// @returns The index of the preferred slot in [BlockCache.table].
+static size_t slotOf(BlockCache cache, BitData start) {
+    // Instructions are word-aligned, so the bottom two bits carry no information.
+    return (start >> 2) & (cache->capacity - 1);
+}
+
+/// Doubles the capacity of the cache, re-inserting every block.
+/// @param cache The cache to grow.
+static void growBlockCache(BlockCache cache) {
+    Block **oldTable = cache->table;
+    size_t oldCapacity = cache->capacity;
+
+    cache->capacity *= 2;
+    cache->table = calloc(cache->capacity, sizeof(Block *));
+    assertFatalNotNull(cache->table, "<Memory> Unable to expand by re-allocate [table]!");
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldTable[i] == NULL) continue;
+
+        size_t j = slotOf(cache, oldTable[i]->start);
+        while (cache->table[j] != NULL) j = (j + 1) & (cache->capacity - 1);
+        cache->table[j] = oldTable[i];
+    }
+
+    free(oldTable);
+}
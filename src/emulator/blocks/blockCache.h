@@ -0,0 +1,114 @@
+///
+/// blockCache.h
+/// Storage and lookup of decoded basic blocks, chained to their successors.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_BLOCK_CACHE_H
+#define EMULATOR_BLOCK_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+#include "const.h"
+#include "error.h"
+#include "executor.h"
+#include "ir.h"
+#include "memory.h"
+#include "registers.h"
+
+/// The maximum number of instructions recorded into a single [Block].
+#define BLOCK_MAX_LENGTH    64
+
+/// The initial number of slots in a [BlockCache]'s table. Must be a power of two.
+#define BLOCK_CACHE_INITIAL 256
+
+/// The size, in bytes, of a [BlockCache]'s region of compiled host code.
+#define NATIVE_REGION_SIZE  (4 * 1024 * 1024)
+
+/// A [Block] compiled to host code, returning whether the whole block was executed, as [executeBlock] does.
+typedef bool (*NativeBlock)(Registers regs, Memory mem);
+
+/// A single instruction of a [Block], decoded and bound to its [Executor].
+typedef struct {
+    /// The decoded instruction.
+    IR ir;
+
+    /// The executor for [ir].
+    Executor execute;
+} BlockEntry;
+
+/// A basic block: a straight-line run of instructions ending at a branch, a halt, or [BLOCK_MAX_LENGTH].
+typedef struct Block {
+    /// The address of the first instruction in the block.
+    BitData start;
+
+    /// The address immediately after the last instruction in the block.
+    BitData end;
+
+    /// Whether the last instruction in the block is a branch.
+    bool branches;
+
+    /// Whether the instruction at [end] is a halt, i.e., execution stops after this block.
+    bool halts;
+
+    /// Whether the block ends in a compare and conditional branch, executed together by [executeCompareBranch].
+    bool fused;
+
+    /// The successor last reached by taking the terminating branch, if any.
+    struct Block *taken;
+
+    /// The successor last reached by falling through to [end], if any.
+    struct Block *fallthrough;
+
+    /// The number of times the block has been interpreted, counting towards its compilation.
+    uint32_t executions;
+
+    /// The compiled host code of the block, or NULL if it has not been compiled.
+    NativeBlock native;
+
+    /// The idle loop the block heads, see [idleLoop.h], or NULL if it does not head one.
+    struct IdleLoop *idle;
+
+    /// The number of instructions in [entries].
+    size_t length;
+
+    /// The instructions of the block, in order.
+    BlockEntry entries[];
+} Block;
+
+/// An open-addressed table of [Block]s, keyed by their start address.
+struct BlockCache_s {
+    /// The table of blocks, NULL marking an empty slot.
+    Block **table;
+
+    /// The number of slots in [table]. Always a power of two.
+    size_t capacity;
+
+    /// The number of [Block]s in [table].
+    size_t count;
+
+    /// The [Memory_s.codeVersion] that every cached block was decoded under.
+    uint64_t codeVersion;
+
+    /// The executable region compiled blocks are emitted into, or NULL until the first compilation.
+    uint8_t *code;
+
+    /// The number of bytes of [code] in use.
+    size_t codeUsed;
+};
+
+BlockCache createBlockCache(void);
+
+void destroyBlockCache(BlockCache cache);
+
+void flushBlockCache(BlockCache cache);
+
+Block *findBlock(BlockCache cache, BitData start);
+
+void insertBlock(BlockCache cache, Block *block);
+
+#endif // EMULATOR_BLOCK_CACHE_H
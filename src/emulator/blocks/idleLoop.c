@@ -0,0 +1,210 @@
+///
+/// idleLoop.c
+/// Recognition of side-effect free counting loops, and skipping them in closed form.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "idleLoop.h"
+
+static void setIteration(IdleLoop *loop, Registers registers, BitData value, BitData bound, BitData step);
+
+static bool isCounterStep(IR *ir, uint8_t *counter);
+
+static BitData branchTarget(BitData address, IR *ir);
+
+static bool solveIterations(BitData start, BitData step, BitData bound, bool sf, uint64_t *iterations);
+
+/// Recognises [block] as the head of an idle counting loop, as described by [IdleLoop].
+/// @param block The freshly recorded block.
+/// @returns The loop, to be stored in [Block.idle], or NULL if [block] is not one.
+/// @remark A loop left by taking its branch also relies on the block at [Block.end] branching back, which is only
+/// known once that block is linked, so is checked by [skipIdleLoop].
+IdleLoop *findIdleLoop(Block *block) {
+    if (!block->branches || block->length < 2 || block->length > 3) return NULL;
+
+    IR *step = &block->entries[0].ir;
+    IR *branch = &block->entries[block->length - 1].ir;
+    if (branch->ir.branchIR.type != BRANCH_CONDITIONAL) return NULL;
+
+    IdleLoop loop = { .setsFlags = block->length == 2 };
+    if (!isCounterStep(step, &loop.counter)) return NULL;
+
+    Immediate_IR *stepIR = &step->ir.immediateIR;
+    enum ArithmeticType stepType = stepIR->opc.arithmeticType;
+    loop.sf = stepIR->sf;
+    loop.subtract = stepType == SUB || stepType == SUBS;
+    loop.step = (BitData) stepIR->operand.arithmetic.imm12 << (stepIR->operand.arithmetic.sh * 12);
+    if (loop.setsFlags != (stepType == ADDS || stepType == SUBS)) return NULL;
+
+    // The comparison, i.e., \code subs xzr, xc, (xb|#bound) \endcode
+    if (!loop.setsFlags) {
+        IR *compare = &block->entries[1].ir;
+        if (compare->type == IMMEDIATE) {
+            Immediate_IR *compareIR = &compare->ir.immediateIR;
+            if (compareIR->opi != IMMEDIATE_ARITHMETIC || compareIR->opc.arithmeticType != SUBS) return NULL;
+            if (compareIR->sf != loop.sf || compareIR->rd != ZERO_REGISTER) return NULL;
+            if (compareIR->operand.arithmetic.rn != loop.counter) return NULL;
+
+            struct Arithmetic *operand = &compareIR->operand.arithmetic;
+            loop.bound = (BitData) operand->imm12 << (operand->sh * 12);
+        } else if (compare->type == REGISTER) {
+            Register_IR *compareIR = &compare->ir.registerIR;
+            if (compareIR->group != ARITHMETIC || compareIR->opc.arithmetic != SUBS) return NULL;
+            if (compareIR->sf != loop.sf || compareIR->rd != ZERO_REGISTER) return NULL;
+            if (compareIR->rn != loop.counter || compareIR->rm == loop.counter || compareIR->operand.imm6 != 0) {
+                return NULL;
+            }
+
+            loop.boundIsRegister = true;
+            loop.bound = compareIR->rm;
+        } else {
+            return NULL;
+        }
+    }
+
+    // Only loops which end on equality can be solved in closed form.
+    enum BranchCondition condition = branch->ir.branchIR.data.conditional.condition;
+    loop.target = branchTarget(block->end - WORD_SIZE, branch);
+    if (condition == NE && loop.target == block->start) {
+        loop.exitTaken = false;
+    } else if (condition == EQ && loop.target != block->start) {
+        loop.exitTaken = true;
+    } else {
+        return NULL;
+    }
+
+    IdleLoop *result = malloc(sizeof(IdleLoop));
+    assertFatalNotNull(result, "<Memory> Unable to allocate [IdleLoop]!");
+    *result = loop;
+    return result;
+}
+
+/// Runs the idle loop headed by [block] to completion in one step, if it would terminate, or else for as many whole
+/// iterations as [budget] allows.
+/// @param block The block heading the loop, i.e., with [Block.idle] set.
+/// @param registers The current virtual registers, with the PC at the start of [block].
+/// @param budget The most instructions to skip.
+/// @returns Whether the loop was skipped, leaving the registers (and instruction count) as if it had been run.
+bool skipIdleLoop(Block *block, Registers registers, uint64_t budget) {
+    IdleLoop *loop = block->idle;
+    uint64_t length = block->length;
+
+    // A loop left by its branch must also be closed by an unconditional branch straight back.
+    if (loop->exitTaken) {
+        Block *back = block->fallthrough;
+        if (back == NULL || back->length != 1 || !back->branches) return false;
+
+        IR *branch = &back->entries[0].ir;
+        if (branch->ir.branchIR.type != BRANCH_UNCONDITIONAL) return false;
+        if (branchTarget(back->start, branch) != block->start) return false;
+        length++;
+    }
+
+    BitData widthMask = loop->sf ? UINT64_MAX : UINT32_MAX;
+    BitData start = getReg(registers, loop->counter) & widthMask;
+    BitData step = (loop->subtract ? -loop->step : loop->step) & widthMask;
+    BitData bound = loop->setsFlags ? 0 : loop->boundIsRegister ? getReg(registers, loop->bound) : loop->bound;
+    bound &= widthMask;
+
+    uint64_t iterations;
+    if (!solveIterations(start, step, bound, loop->sf, &iterations)) return false;
+
+    // The last iteration exits without going back round.
+    uint64_t total;
+    bool overflows = __builtin_mul_overflow(iterations - 1, length, &total);
+    if (!overflows && !__builtin_add_overflow(total, block->length, &total) && total <= budget) {
+        setIteration(loop, registers, bound, bound, step);
+        registers->instructions += total;
+        setRegPC(registers, loop->exitTaken ? loop->target : block->end);
+        return true;
+    }
+
+    // Otherwise, stop at the top of the loop after as many iterations as fit, which are fewer than [iterations].
+    uint64_t fitting = budget / length;
+    if (fitting == 0) return false;
+
+    setIteration(loop, registers, (start + fitting * step) & widthMask, bound, step);
+    registers->instructions += fitting * length;
+    setRegPC(registers, block->start);
+    return true;
+}
+
+/// Sets the counter and flags to what an iteration of [loop] leaves them as.
+/// @param loop The idle loop.
+/// @param registers The current virtual registers.
+/// @param value The counter after the iteration.
+/// @param bound The value the counter is compared against.
+/// @param step The amount the counter is stepped by, i.e., negated for a decrement.
+static void setIteration(IdleLoop *loop, Registers registers, BitData value, BitData bound, BitData step) {
+    BitData widthMask = loop->sf ? UINT64_MAX : UINT32_MAX;
+    setReg(registers, loop->counter, loop->sf, value);
+
+    if (loop->setsFlags) {
+        BitData previous = (value - step) & widthMask;
+        setRegFlags(registers, loop->subtract ? FLAGS_SUB : FLAGS_ADD, loop->sf, previous, loop->step, value);
+    } else {
+        setRegFlags(registers, FLAGS_SUB, loop->sf, value, bound, (value - bound) & widthMask);
+    }
+}
+
+/// Checks whether [ir] steps a counter, i.e., is \code add(s)/sub(s) xc, xc, #step \endcode
+/// @param ir The instruction.
+/// @param counter Set to the counter register, if it is one.
+/// @returns Whether [ir] steps a counter.
+static bool isCounterStep(IR *ir, uint8_t *counter) {
+    if (ir->type != IMMEDIATE || ir->ir.immediateIR.opi != IMMEDIATE_ARITHMETIC) return false;
+
+    Immediate_IR *immediateIR = &ir->ir.immediateIR;
+    if (immediateIR->rd == ZERO_REGISTER || immediateIR->rd != immediateIR->operand.arithmetic.rn) return false;
+
+    *counter = immediateIR->rd;
+    return true;
+}
+
+/// Gets the target of a branch, as [executeBranch] would.
+/// @param address The address of the branch.
+/// @param ir The branch, either unconditional or conditional.
+/// @returns The address branched to.
+static BitData branchTarget(BitData address, IR *ir) {
+    Branch_IR *branchIR = &ir->ir.branchIR;
+    int64_t literal = branchIR->type == BRANCH_UNCONDITIONAL
+                      ? branchIR->data.simm26.data.immediate
+                      : branchIR->data.conditional.simm19.data.immediate;
+    int64_t offset = signExtend(literal, 8 * sizeof(uint32_t));
+    return address + 4 * offset;
+}
+
+/// Solves for the number of iterations until a counter, stepped before each comparison, first equals its bound.
+/// @param start The counter on entry to the loop.
+/// @param step The amount added to the counter each iteration, modulo the width of the loop.
+/// @param bound The value the counter is compared with.
+/// @param sf Whether the loop counts in 64 bits.
+/// @param iterations Set to the smallest \code k >= 1 \endcode with \code start + k * step == bound \endcode
+/// @returns Whether the loop terminates, in a countable number of iterations.
+/// @remark Writing \code step = odd * 2^t \endcode, a solution exists only if \code 2^t \endcode divides the
+/// distance to [bound], and is then unique modulo \code 2^(width - t) \endcode, through the inverse of odd.
+static bool solveIterations(BitData start, BitData step, BitData bound, bool sf, uint64_t *iterations) {
+    unsigned width = sf ? 64 : 32;
+    if ((sf ? step : (uint32_t) step) == 0) return false;
+
+    unsigned shift = __builtin_ctzll(step);
+    BitData distance = (bound - start) & (sf ? UINT64_MAX : UINT32_MAX);
+    if (distance & (((BitData) 1 << shift) - 1)) return false;
+
+    // Newton's iteration doubles the correct low bits of the inverse each time, from the 3 of odd * odd == 1.
+    BitData odd = step >> shift;
+    BitData inverse = odd;
+    for (int i = 0; i < 5; i++) inverse *= 2 - odd * inverse;
+
+    unsigned periodBits = width - shift;
+    BitData periodMask = periodBits == 64 ? UINT64_MAX : ((BitData) 1 << periodBits) - 1;
+    *iterations = (distance >> shift) * inverse & periodMask;
+
+    // A counter which starts on its bound goes all the way round, which is too far to count in 64 bits.
+    if (*iterations == 0) {
+        if (periodBits == 64) return false;
+        *iterations = (uint64_t) 1 << periodBits;
+    }
+    return true;
+}
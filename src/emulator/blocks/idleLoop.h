@@ -0,0 +1,67 @@
+///
+/// idleLoop.h
+/// Recognition of side-effect free counting loops, and skipping them in closed form.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_IDLE_LOOP_H
+#define EMULATOR_IDLE_LOOP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "blockCache.h"
+#include "const.h"
+#include "error.h"
+#include "ir.h"
+#include "registers.h"
+
+/// A counting loop headed by a [Block], which steps a counter register by a constant until it equals a bound.
+/// @remark Recognised loops are one of
+/// \code
+/// loop: add  xc, xc, #step     loop: add  xc, xc, #step     loop: subs xc, xc, #step
+///       cmp  xc, (xb|#bound)         cmp  xc, (xb|#bound)         b.ne loop
+///       b.ne loop                    b.eq exit
+///                                    b    loop
+/// \endcode
+/// (or \code sub \endcode, \code adds \endcode, either width, and the flag-setting step in the middle form),
+/// which do nothing but count.
+struct IdleLoop {
+    /// The counter register.
+    uint8_t counter;
+
+    /// Whether the loop counts in 64 bits.
+    bool sf;
+
+    /// Whether the counter counts down, rather than up.
+    bool subtract;
+
+    /// The amount the counter is stepped by each iteration.
+    BitData step;
+
+    /// Whether the counter's step sets the flags, and so is compared with zero, without a \code cmp \endcode.
+    bool setsFlags;
+
+    /// Whether the counter is compared with register [bound], rather than an immediate.
+    bool boundIsRegister;
+
+    /// The register, or immediate, the counter is compared with.
+    BitData bound;
+
+    /// Whether the loop is left by taking its conditional branch (to [target]), rather than by falling through it.
+    bool exitTaken;
+
+    /// The target of the loop's conditional branch.
+    BitData target;
+};
+
+/// Type definition of an idle loop, see [IdleLoop].
+typedef struct IdleLoop IdleLoop;
+
+IdleLoop *findIdleLoop(Block *block);
+
+bool skipIdleLoop(Block *block, Registers registers, uint64_t budget);
+
+#endif // EMULATOR_IDLE_LOOP_H
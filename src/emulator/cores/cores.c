@@ -0,0 +1,117 @@
+///
+/// cores.c
+/// Runs several guest cores, each with its own registers, over one shared memory.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "cores.h"
+
+static void *runCore(void *argument);
+
+static bool stepCore(Core *core, Memory memory, uint64_t budget);
+
+/// Creates a machine of [count] cores over [memory], none of which have run yet.
+/// @param memory The memory every core runs over.
+/// @param count The number of cores.
+/// @param entries The PC each core starts at, or NULL for every core to start at 0.
+/// @param engine The engine every core runs with.
+/// @param maxInstructions The instruction count at which any one core is stopped.
+/// @returns The machine, to be freed by [freeMachine] before [memory] is.
+Machine createMachine(Memory memory, size_t count, const BitData *entries, Engine engine, uint64_t maxInstructions) {
+    assertFatalWithArgs(count != 0 && count <= MAX_CORES, "A machine needs between 1 and %d cores!", MAX_CORES);
+
+    Machine machine = malloc(sizeof(Machine_s));
+    assertFatalNotNull(machine, "<Cores> Unable to allocate [Machine_s]!");
+
+    machine->cores = calloc(count, sizeof(Core));
+    assertFatalNotNull(machine->cores, "<Cores> Unable to allocate [Core]s!");
+
+    machine->count = count;
+    machine->memory = memory;
+    machine->engine = engine;
+    machine->maxInstructions = maxInstructions;
+
+    for (size_t i = 0; i < count; i++) {
+        Core *core = &machine->cores[i];
+        core->registers = createRegs();
+        if (entries != NULL) setRegPC(&core->registers, entries[i]);
+        core->reason = STOP_BUDGET;
+        core->machine = machine;
+    }
+
+    return machine;
+}
+
+/// Runs every core of [machine] until it halts, faults, or runs out of instructions.
+/// @param machine The machine.
+/// @param quantum The number of instructions each core runs for at a time, taking turns in order on this thread; or
+/// 0 for every core to run at once, on a host thread of its own.
+/// @remark Taking turns is deterministic, so is what to debug a race with. Cores on their own threads each run
+/// through a view of the (fast) memory, see [createMemView]. Either way, a fault only stops the core it occurs on.
+void runMachine(Machine machine, uint64_t quantum) {
+    // A lone core runs straight on the memory, exactly as a single-core run would.
+    if (machine->count == 1) quantum = UINT64_MAX;
+
+    if (quantum != 0) {
+        bool running = true;
+        while (running) {
+            running = false;
+            for (size_t i = 0; i < machine->count; i++) {
+                Core *core = &machine->cores[i];
+                if (core->reason != STOP_BUDGET || core->registers.instructions >= machine->maxInstructions) continue;
+
+                uint64_t remaining = machine->maxInstructions - core->registers.instructions;
+                running |= stepCore(core, machine->memory, remaining < quantum ? remaining : quantum);
+            }
+        }
+        return;
+    }
+
+    pthread_t *threads = malloc(machine->count * sizeof(pthread_t));
+    assertFatalNotNull(threads, "<Cores> Unable to allocate core threads!");
+
+    for (size_t i = 0; i < machine->count; i++) machine->cores[i].view = createMemView(machine->memory);
+    for (size_t i = 0; i < machine->count; i++) {
+        assertFatal(pthread_create(&threads[i], NULL, runCore, &machine->cores[i]) == 0,
+                    "<Cores> Unable to start core!");
+    }
+
+    for (size_t i = 0; i < machine->count; i++) pthread_join(threads[i], NULL);
+
+    free(threads);
+}
+
+/// Frees the given machine, but not its memory.
+/// @param machine The machine.
+void freeMachine(Machine machine) {
+    for (size_t i = 0; i < machine->count; i++) {
+        if (machine->cores[i].view != NULL) freeMem(machine->cores[i].view);
+    }
+
+    free(machine->cores);
+    free(machine);
+}
+
+/// Runs a core on a host thread of its own, through its view of the shared memory.
+/// @param argument The [Core].
+/// @returns NULL.
+static void *runCore(void *argument) {
+    Core *core = argument;
+    uint64_t maxInstructions = core->machine->maxInstructions;
+    if (core->registers.instructions < maxInstructions) {
+        stepCore(core, core->view, maxInstructions - core->registers.instructions);
+    }
+    return NULL;
+}
+
+/// Runs [core] for at most [budget] instructions.
+/// @param core The core.
+/// @param memory The memory to run it over.
+/// @param budget The most instructions to run.
+/// @returns Whether the core may run further, i.e., only stopped for having used up [budget].
+static bool stepCore(Core *core, Memory memory, uint64_t budget) {
+    core->reason = runFor(&core->registers, memory, core->machine->engine, budget);
+    if (core->reason == STOP_FAULT) strcpy(core->error, fatalError);
+    return core->reason == STOP_BUDGET;
+}
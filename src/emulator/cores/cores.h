@@ -0,0 +1,76 @@
+///
+/// cores.h
+/// Runs several guest cores, each with its own registers, over one shared memory.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_CORES_H
+#define EMULATOR_CORES_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "const.h"
+#include "emulatorDelegate.h"
+#include "error.h"
+#include "memory.h"
+#include "registers.h"
+
+/// The most guest cores a machine may have; cores running on threads each hold a fast memory's view.
+#define MAX_CORES             MAX_FAST_MEMORIES
+
+/// The number of instructions each core runs for at a time when cores take turns, unless otherwise given.
+#define DEFAULT_CORE_QUANTUM  1000
+
+/// A guest core, running over the memory of its [Machine_s].
+typedef struct {
+    /// The registers of the core.
+    Registers_s registers;
+
+    /// Why the core stopped, once it has.
+    StopReason reason;
+
+    /// The fatal error which stopped the core, if [reason] is [STOP_FAULT].
+    char error[FATAL_MESSAGE_SIZE];
+
+    /// The view of the shared memory the core runs through on its own thread, or NULL when it runs on the memory
+    /// itself.
+    Memory view;
+
+    /// The machine the core belongs to.
+    struct Machine_s *machine;
+} Core;
+
+/// Several guest cores sharing one memory.
+typedef struct Machine_s {
+    /// The cores, in order.
+    Core *cores;
+
+    /// The number of [cores].
+    size_t count;
+
+    /// The memory every core runs over.
+    Memory memory;
+
+    /// The engine every core runs with.
+    Engine engine;
+
+    /// The instruction count at which any one core is stopped.
+    uint64_t maxInstructions;
+} Machine_s;
+
+/// Type definition of a pointer to [Machine_s].
+typedef Machine_s *Machine;
+
+Machine createMachine(Memory memory, size_t count, const BitData *entries, Engine engine, uint64_t maxInstructions);
+
+void runMachine(Machine machine, uint64_t quantum);
+
+void freeMachine(Machine machine);
+
+#endif // EMULATOR_CORES_H
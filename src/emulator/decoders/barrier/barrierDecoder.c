@@ -0,0 +1,19 @@
+///
+/// barrierDecoder.c
+/// Decodes a binary word of a barrier instruction to its [IR].
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "barrierDecoder.h"
+
+/// Decodes a binary word of a barrier instruction to its [IR].
+/// @param word The [Instruction] to decode.
+/// @returns The [IR] of word.
+IR decodeBarrier(Instruction word) {
+    enum BarrierType type = decompose(word, BARRIER_TYPE_M);
+    assertFatal(type == DSB || type == DMB || type == ISB, "Invalid instruction format!");
+
+    Barrier_IR barrierIR = (Barrier_IR) { .type = type, .option = decompose(word, BARRIER_OPTION_M) };
+    return (IR) { .type = BARRIER, .ir.barrierIR = barrierIR };
+}
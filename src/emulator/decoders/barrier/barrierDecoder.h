@@ -0,0 +1,17 @@
+///
+/// barrierDecoder.h
+/// Decodes a binary word of a barrier instruction to its [IR].
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_BARRIER_DECODER_H
+#define EMULATOR_BARRIER_DECODER_H
+
+#include "const.h"
+#include "error.h"
+#include "ir.h"
+
+IR decodeBarrier(Instruction word);
+
+#endif // EMULATOR_BARRIER_DECODER_H
@@ -22,29 +22,14 @@ IR decodeBranch(Instruction word) {
     } else if ((word & BRANCH_REGISTER_M) == BRANCH_REGISTER_B) {
         branchIR = (Branch_IR) { .type = BRANCH_REGISTER, .data.xn = decompose(word, BRANCH_REGISTER_XN_M) };
     } else if ((word & BRANCH_CONDITIONAL_M) == BRANCH_CONDITIONAL_B) {
-        struct Conditional conditional;
+        struct Conditional conditional = { .simm19.isLabel = false };
 
         // Get the 19-bit offset as a 32-bit unsigned integer
         int32_t simm19 = decompose(word, BRANCH_CONDITIONAL_SIMM19_M);
         conditional.simm19.data.immediate = signExtend(simm19, BRANCH_CONDITIONAL_SIMM19_N);
 
-        // Get the condition code from the instruction and check if it's valid
-        uint8_t condition = decompose(word, BRANCH_CONDITIONAL_COND_M);
-
-        switch (condition) {
-            case EQ:
-            case NE:
-            case GE:
-            case LT:
-            case GT:
-            case LE:
-            case AL:
-                conditional.condition = condition;
-                break;
-
-            default:
-                throwFatal("Invalid condition code!");
-        }
+        // Get the condition code from the instruction; all 16 encodings are valid.
+        conditional.condition = decompose(word, BRANCH_CONDITIONAL_COND_M);
 
         branchIR = (Branch_IR) { .type = BRANCH_CONDITIONAL, .data.conditional = conditional };
     } else {
@@ -57,7 +57,21 @@ IR decodeLoadStore(Instruction word) {
         offset = signExtend(offset, LOAD_STORE_LITERAL_SIMM19_N);
 
         loadStoreIR.type = LOAD_LITERAL;
+        loadStoreIR.data.simm19.isLabel = false;
         loadStoreIR.data.simm19.data.immediate = offset;
+    } else if ((word & LOAD_STORE_EXCLUSIVE_M) == LOAD_STORE_EXCLUSIVE_B) {
+        struct Exclusive exclusive = (struct Exclusive) {
+                .l = decompose(word, LOAD_STORE_EXCLUSIVE_L_M),
+                .ordered = decompose(word, LOAD_STORE_EXCLUSIVE_O0_M),
+                .rs = decompose(word, LOAD_STORE_EXCLUSIVE_RS_M),
+                .xn = decompose(word, LOAD_STORE_DATA_XN_M),
+        };
+
+        // A load exclusive has no status register.
+        assertFatal(!exclusive.l || exclusive.rs == LOAD_STORE_EXCLUSIVE_NO_RS, "Invalid instruction format!");
+
+        loadStoreIR.type = LOAD_STORE_EXCLUSIVE;
+        loadStoreIR.data.exclusive = exclusive;
     } else {
         throwFatal("Invalid instruction format!");
     }
@@ -0,0 +1,97 @@
+///
+/// gpio.c
+/// A model of the Raspberry Pi 3's general-purpose I/O controller.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "gpio.h"
+
+static uint32_t readGpio(void *state, size_t offset);
+
+static void writeGpio(void *state, size_t offset, uint32_t value);
+
+static void setLevels(Gpio gpio, uint64_t pins, bool high);
+
+/// Creates a GPIO controller, with every pin an input at a low level.
+/// @param log Where changes to the level of output pins are logged, or NULL.
+/// @returns The device, to be attached with [attachDevice].
+Device createGpio(FILE *log) {
+    Gpio gpio = calloc(1, sizeof(Gpio_s));
+    assertFatalNotNull(gpio, "<GPIO> Unable to allocate [Gpio_s]!");
+    gpio->log = log;
+
+    return (Device) {
+        .base = GPIO_BASE,
+        .size = GPIO_SIZE,
+        .state = gpio,
+        .read = readGpio,
+        .write = writeGpio,
+        .destroy = free
+    };
+}
+
+/// Reads a register of the GPIO controller.
+/// @param state The [Gpio].
+/// @param offset The offset of the register.
+/// @returns The value of the register; write-only and reserved registers read as zero.
+static uint32_t readGpio(void *state, size_t offset) {
+    Gpio gpio = state;
+
+    if (offset <= GPFSEL5) return gpio->select[offset / DEVICE_WORD_SIZE];
+
+    switch (offset) {
+        case GPLEV0:
+            return (uint32_t) gpio->level;
+
+        case GPLEV1:
+            return (uint32_t) (gpio->level >> 32);
+
+        default:
+            return 0;
+    }
+}
+
+/// Writes a register of the GPIO controller.
+/// @param state The [Gpio].
+/// @param offset The offset of the register.
+/// @param value The value written; writes to read-only and reserved registers are ignored.
+static void writeGpio(void *state, size_t offset, uint32_t value) {
+    Gpio gpio = state;
+
+    if (offset <= GPFSEL5) {
+        gpio->select[offset / DEVICE_WORD_SIZE] = value;
+        return;
+    }
+
+    switch (offset) {
+        case GPSET0:
+        case GPSET1:
+            setLevels(gpio, (uint64_t) value << (offset == GPSET1 ? 32 : 0), true);
+            break;
+
+        case GPCLR0:
+        case GPCLR1:
+            setLevels(gpio, (uint64_t) value << (offset == GPCLR1 ? 32 : 0), false);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/// Drives the given output pins high or low, logging those whose level changes.
+/// @param gpio The GPIO controller.
+/// @param pins The pins to drive, one bit per pin; input pins are left as they are.
+/// @param high Whether to drive the pins high.
+static void setLevels(Gpio gpio, uint64_t pins, bool high) {
+    for (unsigned pin = 0; pin < GPIO_PINS; pin++) {
+        if (!(pins >> pin & 1)) continue;
+
+        uint32_t select = gpio->select[pin / GPIO_PINS_PER_SELECT] >> pin % GPIO_PINS_PER_SELECT * 3 & 0x7;
+        if (select != GPIO_OUTPUT || (bool) (gpio->level >> pin & 1) == high) continue;
+
+        gpio->level ^= (uint64_t) 1 << pin;
+        if (gpio->log != NULL) fprintf(gpio->log, "GPIO %u: %s\n", pin, high ? "high" : "low");
+    }
+}
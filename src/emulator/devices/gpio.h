@@ -0,0 +1,63 @@
+///
+/// gpio.h
+/// A model of the Raspberry Pi 3's general-purpose I/O controller.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_GPIO_H
+#define EMULATOR_GPIO_H
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bus.h"
+#include "error.h"
+
+/// The address of the GPIO controller's registers.
+#define GPIO_BASE    0x3f200000
+
+/// The number of bytes of the GPIO controller's registers.
+#define GPIO_SIZE    0xb4
+
+/// The number of GPIO pins.
+#define GPIO_PINS    54
+
+/// The number of pins whose function is selected by each of the GPFSELn registers.
+#define GPIO_PINS_PER_SELECT 10
+
+/// The function select value of an output pin.
+#define GPIO_OUTPUT  0x1
+
+/// The offsets of the registers of the GPIO controller.
+enum GpioRegister {
+    GPFSEL0 = 0x00,
+    GPFSEL5 = 0x14,
+    GPSET0  = 0x1c,
+    GPSET1  = 0x20,
+    GPCLR0  = 0x28,
+    GPCLR1  = 0x2c,
+    GPLEV0  = 0x34,
+    GPLEV1  = 0x38
+};
+
+/// The state of the GPIO controller.
+typedef struct {
+    /// The GPFSELn registers, selecting the function of each pin.
+    uint32_t select[GPFSEL5 / DEVICE_WORD_SIZE + 1];
+
+    /// The level of each pin, one bit per pin.
+    uint64_t level;
+
+    /// Where changes to the level of output pins are logged, or NULL.
+    FILE *log;
+} Gpio_s;
+
+/// Type definition representing a pointer to the state of the GPIO controller.
+typedef Gpio_s *Gpio;
+
+Device createGpio(FILE *log);
+
+#endif // EMULATOR_GPIO_H
@@ -0,0 +1,70 @@
+///
+/// uart.c
+/// A model of the Raspberry Pi 3's PL011 UART, transmitting to a host file.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "uart.h"
+
+static uint32_t readUart(void *state, size_t offset);
+
+static void writeUart(void *state, size_t offset, uint32_t value);
+
+/// Creates a UART, which transmits instantly and never receives.
+/// @param out Where transmitted bytes are written.
+/// @returns The device, to be attached with [attachDevice].
+Device createUart(FILE *out) {
+    Uart uart = calloc(1, sizeof(Uart_s));
+    assertFatalNotNull(uart, "<UART> Unable to allocate [Uart_s]!");
+    uart->out = out;
+
+    return (Device) {
+        .base = UART_BASE,
+        .size = UART_SIZE,
+        .state = uart,
+        .read = readUart,
+        .write = writeUart,
+        .destroy = free
+    };
+}
+
+/// Reads a register of the UART.
+/// @param state The [Uart].
+/// @param offset The offset of the register.
+/// @returns The value of the register.
+/// @remark Nothing is ever received, and the transmit FIFO is always empty.
+static uint32_t readUart(void *state, size_t offset) {
+    Uart uart = state;
+
+    switch (offset) {
+        case UART_DR:
+            return 0;
+
+        case UART_FR:
+            return UART_RXFE | UART_TXFE;
+
+        default:
+            return uart->registers[offset / DEVICE_WORD_SIZE];
+    }
+}
+
+/// Writes a register of the UART.
+/// @param state The [Uart].
+/// @param offset The offset of the register.
+/// @param value The value written; a write to the data register transmits its low byte.
+static void writeUart(void *state, size_t offset, uint32_t value) {
+    Uart uart = state;
+
+    switch (offset) {
+        case UART_DR:
+            fputc((int) (value & 0xff), uart->out);
+            break;
+
+        case UART_FR:
+            break;
+
+        default:
+            uart->registers[offset / DEVICE_WORD_SIZE] = value;
+    }
+}
@@ -0,0 +1,50 @@
+///
+/// uart.h
+/// A model of the Raspberry Pi 3's PL011 UART, transmitting to a host file.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_UART_H
+#define EMULATOR_UART_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bus.h"
+#include "error.h"
+
+/// The address of the UART's registers.
+#define UART_BASE    0x3f201000
+
+/// The number of bytes of the UART's registers.
+#define UART_SIZE    0x90
+
+/// Flag of the flag register: the receive FIFO is empty.
+#define UART_RXFE    0x10
+
+/// Flag of the flag register: the transmit FIFO is empty.
+#define UART_TXFE    0x80
+
+/// The offsets of the registers of the UART.
+enum UartRegister {
+    UART_DR = 0x00,
+    UART_FR = 0x18
+};
+
+/// The state of the UART.
+typedef struct {
+    /// The control registers, which are only stored and read back.
+    uint32_t registers[UART_SIZE / DEVICE_WORD_SIZE];
+
+    /// Where transmitted bytes are written.
+    FILE *out;
+} Uart_s;
+
+/// Type definition representing a pointer to the state of the UART.
+typedef Uart_s *Uart;
+
+Device createUart(FILE *out);
+
+#endif // EMULATOR_UART_H
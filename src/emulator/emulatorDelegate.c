@@ -6,17 +6,31 @@
 ///
 
 #include "emulatorDelegate.h"
+#include "hooks.h"
+
+static StopReason runUntil(Registers registers, Memory memory, Engine engine, uint64_t limit);
+
+static Block *recordBlock(BlockCache cache, Registers registers, Memory memory);
+
+static bool executeBlock(Block *block, BlockCache cache, Registers registers, Memory memory);
+
+static bool dispatchBlock(Block *block, Engine engine, BlockCache cache, Registers registers, Memory memory,
+                          uint64_t limit);
+
+static Block *successorOf(Block *block, BitData pc);
+
+static void linkBlock(Block *block, Block *successor);
 
 /// Get the corresponding [IRExecutor] for this [irObject].
 /// @param instruction The binary representation of the instruction.
-/// @returns The corresponding [IRExecutor].
+/// @returns The corresponding [IRExecutor], specialised for data processing instructions.
 Executor getExecuteFunction(IR *irObject) {
     switch (irObject->type) {
         case IMMEDIATE:
-            return executeImmediate;
+            return immediateVariant(&irObject->ir.immediateIR);
 
         case REGISTER:
-            return executeRegister;
+            return registerVariant(&irObject->ir.registerIR);
 
         case LOAD_STORE:
             return executeLoadStore;
@@ -24,6 +38,9 @@ Executor getExecuteFunction(IR *irObject) {
         case BRANCH:
             return executeBranch;
 
+        case BARRIER:
+            return executeBarrier;
+
         default:
             throwFatal("Invalid IR!");
     }
@@ -33,6 +50,9 @@ Executor getExecuteFunction(IR *irObject) {
 /// @param instruction The binary representation of the instruction.
 /// @returns The corresponding [BinaryParser].
 Decoder getDecodeFunction(const Instruction instruction) {
+    // Barriers are system instructions, encoded among the branches.
+    if ((instruction & BARRIER_M) == BARRIER_B) return decodeBarrier;
+
     Component op0 = decompose(instruction, OP0_M);
     if ((op0 & OP0_IMMEDIATE_M) == OP0_IMMEDIATE_C) {
         return decodeImmediate;
@@ -47,21 +67,299 @@ Decoder getDecodeFunction(const Instruction instruction) {
     throwFatal("Invalid binary instruction!");
 }
 
-/// Executes [instruction] given context.
-/// @param instruction The binary instruction to execute.
+/// Executes [instruction] given context, and fetches the next one.
+/// @param instruction The binary instruction to execute, replaced by the one at the new PC.
 /// @param registers The current virtual registers.
 /// @param memory The address of the virtual memory.
 void execute(Instruction *instruction, Registers registers, Memory memory) {
+    executeInstruction(*instruction, registers, memory);
+
+    // Fetch next instruction
+    *instruction = readMem(memory, false, getRegPC(registers));
+}
+
+/// Executes [instruction] given context, i.e., the instruction at the PC.
+/// @param instruction The binary instruction to execute.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+void executeInstruction(Instruction instruction, Registers registers, Memory memory) {
     // Store the address in the PC before execution.
     BitData pcVal = getRegPC(registers);
 
-    // Decode and execute.
-    IR ir = getDecodeFunction(*instruction)(*instruction);
-    getExecuteFunction(&ir)(&ir, registers, memory);
+    // Decode, reusing the cached decoding of this address if there is one, and execute.
+    IR decoded;
+    IR *ir = getCachedIR(memory, pcVal);
+    if (ir == NULL) {
+        decoded = getDecodeFunction(instruction)(instruction);
+        ir = cacheIR(memory, pcVal, decoded);
+        if (ir == NULL) ir = &decoded;
+    }
+    getExecuteFunction(ir)(ir, registers, memory);
+    registers->instructions++;
 
     // Increment PC only when no branch or jump instructions applied.
     if (pcVal == getRegPC(registers)) incRegPC(registers);
+}
 
-    // Fetch next instruction
-    *instruction = readMem(memory, false, getRegPC(registers));
+/// Runs the program from the current PC until it reaches a halt, with the given engine.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @param engine The engine to execute blocks with.
+/// @remark Errors are raised as usual, i.e., as configured by [JUMP_ON_ERROR].
+void run(Registers registers, Memory memory, Engine engine) {
+    runUntil(registers, memory, engine, UINT64_MAX);
+}
+
+/// Runs the program from the current PC for at most [maxInstructions] instructions, with the given engine.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @param engine The engine to execute blocks with.
+/// @param maxInstructions The most instructions to execute before stopping.
+/// @returns Why execution stopped; the registers and memory are left exactly as at that point, so another call
+/// continues where this one left off.
+/// @remark Fatal errors are caught, leaving their message in [fatalError], whatever [JUMP_ON_ERROR] is set to.
+StopReason runFor(Registers registers, Memory memory, Engine engine, uint64_t maxInstructions) {
+    bool jumpOnError = JUMP_ON_ERROR;
+    jmp_buf callerBuffer;
+    memcpy(callerBuffer, fatalBuffer, sizeof(jmp_buf));
+
+    uint64_t limit = registers->instructions + maxInstructions;
+    if (limit < registers->instructions) limit = UINT64_MAX;
+
+    volatile StopReason reason = STOP_FAULT;
+    JUMP_ON_ERROR = true;
+    if (!setjmp(fatalBuffer)) reason = runUntil(registers, memory, engine, limit);
+
+    JUMP_ON_ERROR = jumpOnError;
+    memcpy(fatalBuffer, callerBuffer, sizeof(jmp_buf));
+    return reason;
+}
+
+/// Runs the program from the current PC until it reaches a halt, or [Registers_s.instructions] reaches [limit].
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @param engine The engine to execute blocks with.
+/// @param limit The instruction count to stop at.
+/// @returns Why execution stopped, i.e., [STOP_HALTED] or [STOP_BUDGET].
+/// @remark For the block-based engines, blocks are recorded (and cached in [memory]) the first time they run,
+/// and chained to their successors so that tight loops never go back to the cache's table. Within a block's length
+/// of [limit], instructions are stepped one at a time instead, so as to stop exactly on it. While any hook is
+/// attached to [memory], every engine gives way to [runHooked].
+static StopReason runUntil(Registers registers, Memory memory, Engine engine, uint64_t limit) {
+    if (memory->hooks != NULL) return runHooked(registers, memory, limit);
+
+    switch (engine) {
+        case REFERENCE_ENGINE: {
+            Instruction instruction = readMem(memory, false, getRegPC(registers));
+            while (instruction != HALT) {
+                if (registers->instructions >= limit) return STOP_BUDGET;
+                execute(&instruction, registers, memory);
+            }
+            return STOP_HALTED;
+        }
+
+        case THREADED_ENGINE:
+            return runThreaded(registers, memory, limit) ? STOP_HALTED : STOP_BUDGET;
+
+        default:
+            break;
+    }
+
+    if (memory->blocks == NULL) memory->blocks = createBlockCache();
+    BlockCache cache = memory->blocks;
+
+    Block *block = NULL;
+    bool completed = false;
+    while (true) {
+        // A write has landed on decoded code, so every block (and link between them) may be stale.
+        if (cache->codeVersion != memory->codeVersion) {
+            flushBlockCache(cache);
+            cache->codeVersion = memory->codeVersion;
+            block = NULL;
+        }
+
+        // Stop if the last block fell through onto a halt.
+        if (block != NULL && completed && block->halts) return STOP_HALTED;
+
+        BitData pc = getRegPC(registers);
+
+        // Blocks are only tracked at word-aligned addresses, and only run whole, so step anything else one at a time.
+        if (pc % WORD_SIZE != 0 || limit - registers->instructions < BLOCK_MAX_LENGTH) {
+            Instruction instruction = readMem(memory, false, pc);
+            if (instruction == HALT) return STOP_HALTED;
+            if (registers->instructions >= limit) return STOP_BUDGET;
+            execute(&instruction, registers, memory);
+            block = NULL;
+            continue;
+        }
+
+        // Follow the chained successor if there is one, then fall back to the table.
+        Block *next = (block != NULL && completed) ? successorOf(block, pc) : NULL;
+        if (next == NULL) {
+            next = findBlock(cache, pc);
+            if (next == NULL) {
+                // The first run of a block is what records it.
+                next = recordBlock(cache, registers, memory);
+                completed = true;
+            } else {
+                completed = dispatchBlock(next, engine, cache, registers, memory, limit);
+            }
+            if (block != NULL) linkBlock(block, next);
+        } else {
+            completed = dispatchBlock(next, engine, cache, registers, memory, limit);
+        }
+
+        block = next;
+    }
+}
+
+/// Records the block starting at the current PC into [cache], executing each instruction as it is recorded.
+/// @param cache The cache to record the block into.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @returns The recorded [Block].
+/// @remark Recording while executing means that instructions are decoded, and any errors raised, in exactly the
+/// order [execute] would have.
+static Block *recordBlock(BlockCache cache, Registers registers, Memory memory) {
+    BlockEntry entries[BLOCK_MAX_LENGTH];
+    size_t length = 0;
+    bool branches = false;
+    bool halts = false;
+
+    BitData start = getRegPC(registers);
+    BitData pc = start;
+    while (length < BLOCK_MAX_LENGTH) {
+        Instruction instruction = readMem(memory, false, pc);
+
+        // Even a halt is decoded, so that overwriting it invalidates this block.
+        IR *ir = getCachedIR(memory, pc);
+        if (ir == NULL) ir = cacheIR(memory, pc, getDecodeFunction(instruction)(instruction));
+
+        if (instruction == HALT) {
+            halts = true;
+            break;
+        }
+
+        BlockEntry *entry = &entries[length++];
+        *entry = (BlockEntry) { .ir = *ir, .execute = getExecuteFunction(ir) };
+        entry->execute(&entry->ir, registers, memory);
+        registers->instructions++;
+
+        if (entry->ir.type == BRANCH) {
+            branches = true;
+            if (getRegPC(registers) == pc) incRegPC(registers);
+            break;
+        }
+
+        incRegPC(registers);
+        pc += WORD_SIZE;
+    }
+
+    Block *block = malloc(sizeof(Block) + length * sizeof(BlockEntry));
+    assertFatalNotNull(block, "<Memory> Unable to allocate [Block]!");
+
+    *block = (Block) {
+        .start = start,
+        .end = start + length * WORD_SIZE,
+        .branches = branches,
+        .halts = halts,
+        .fused = branches && length >= 2 && fusesWithBranch(&entries[length - 2].ir, &entries[length - 1].ir),
+        .taken = NULL,
+        .fallthrough = NULL,
+        .executions = 0,
+        .native = NULL,
+        .idle = NULL,
+        .length = length,
+    };
+    memcpy(block->entries, entries, length * sizeof(BlockEntry));
+    block->idle = findIdleLoop(block);
+
+    insertBlock(cache, block);
+    return block;
+}
+
+/// Executes every instruction of [block], leaving the PC at its successor.
+/// @param block The block to execute.
+/// @param cache The cache that [block] belongs to.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @returns Whether the whole block was executed; false if a store modified decoded code part-way through.
+static bool executeBlock(Block *block, BlockCache cache, Registers registers, Memory memory) {
+    // Only the terminating branch can move the PC anywhere other than the next instruction.
+    size_t straightLength = block->branches ? block->length - 1 : block->length;
+    if (block->fused) straightLength--;
+
+    for (size_t i = 0; i < straightLength; i++) {
+        BlockEntry *entry = &block->entries[i];
+        entry->execute(&entry->ir, registers, memory);
+        incRegPC(registers);
+
+        // A store may have overwritten the rest of this very block, or a barrier discarded it.
+        if ((entry->ir.type == LOAD_STORE || entry->ir.type == BARRIER) && cache->codeVersion != memory->codeVersion) {
+            return false;
+        }
+    }
+
+    if (block->fused) {
+        executeCompareBranch(&block->entries[straightLength].ir, &block->entries[straightLength + 1].ir, registers);
+    } else if (block->branches) {
+        BlockEntry *entry = &block->entries[straightLength];
+        BitData pcVal = getRegPC(registers);
+        entry->execute(&entry->ir, registers, memory);
+        if (pcVal == getRegPC(registers)) incRegPC(registers);
+    }
+
+    return true;
+}
+
+/// Executes [block] with [engine], compiling it once it is hot if [engine] is [JIT_ENGINE].
+/// @param block The block to execute.
+/// @param engine The engine to execute [block] with.
+/// @param cache The cache that [block] belongs to.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @param limit The instruction count to stop at, which is at least [block]'s length away.
+/// @returns Whether the whole block was executed, as for [executeBlock].
+/// @remark If [block] heads an idle loop, as much of the loop as [limit] allows is skipped instead, see
+/// [skipIdleLoop].
+static bool dispatchBlock(Block *block, Engine engine, BlockCache cache, Registers registers, Memory memory,
+                          uint64_t limit) {
+    if (block->idle != NULL && skipIdleLoop(block, registers, limit - registers->instructions)) return true;
+
+    bool completed;
+    if (block->native != NULL) {
+        completed = block->native(registers, memory);
+    } else {
+        completed = executeBlock(block, cache, registers, memory);
+
+        // An incomplete block is about to be flushed, so is not worth compiling.
+        if (completed && engine == JIT_ENGINE && ++block->executions == JIT_THRESHOLD) {
+            compileBlock(cache, block, memory);
+        }
+    }
+
+    // An incomplete block stops just after the store which cut it short.
+    registers->instructions += completed ? block->length : (getRegPC(registers) - block->start) / WORD_SIZE;
+    return completed;
+}
+
+/// Gets the chained successor of [block] which starts at [pc], if there is one.
+/// @param block The block which was just executed.
+/// @param pc The address execution continues from.
+/// @returns The successor [Block], or NULL if [block] has not been chained to [pc].
+static Block *successorOf(Block *block, BitData pc) {
+    if (block->taken != NULL && block->taken->start == pc) return block->taken;
+    if (block->fallthrough != NULL && block->fallthrough->start == pc) return block->fallthrough;
+    return NULL;
+}
+
+/// Chains [successor] to [block], replacing whichever link it would take the place of.
+/// @param block The block which was just executed.
+/// @param successor The block which executed after it.
+static void linkBlock(Block *block, Block *successor) {
+    if (successor->start == block->end) {
+        block->fallthrough = successor;
+    } else {
+        block->taken = successor;
+    }
 }
@@ -8,19 +8,30 @@
 #ifndef EMULATOR_PROCESS_H
 #define EMULATOR_PROCESS_H
 
+#include "barrierDecoder.h"
+#include "barrierExecutor.h"
+#include "blockCache.h"
 #include "branchDecoder.h"
 #include "branchExecutor.h"
+#include "compareBranchExecutor.h"
 #include "const.h"
+#include "emulatorPlugin.h"
 #include "error.h"
+#include "idleLoop.h"
 #include "immediateDecoder.h"
 #include "immediateExecutor.h"
 #include "ir.h"
+#include "jit.h"
 #include "loadStoreDecoder.h"
 #include "loadStoreExecutor.h"
 #include "memory.h"
 #include "registerDecoder.h"
 #include "registerExecutor.h"
 #include "registers.h"
+#include "threaded.h"
+
+/// The halt instruction, i.e., \code and x0, x0, x0 \endcode
+#define HALT             0x8a000000
 
 /// OP0 Mask
 #define OP0_M            mask(28, 25)
@@ -49,14 +60,34 @@
 /// The code for op0 of a Branch binary instruction.
 #define OP0_BRANCH_C     b(1010)
 
-typedef void (*Executor)(IR *irObject, Registers regs, Memory mem);
-
 typedef IR (*Decoder)(Instruction instruction);
 
+/// The ways [run] can execute a program.
+typedef enum {
+    /// Fetches, decodes, and executes one instruction at a time through [execute]. The reference for every other
+    /// engine's behaviour.
+    REFERENCE_ENGINE,
+
+    /// Interprets cached, chained basic blocks.
+    BLOCK_ENGINE,
+
+    /// Dispatches each instruction straight to a handler specialised for it, with computed goto.
+    THREADED_ENGINE,
+
+    /// As [BLOCK_ENGINE], but compiles hot blocks to host machine code where supported.
+    JIT_ENGINE
+} Engine;
+
 Executor getExecuteFunction(IR *irObject);
 
 Decoder getDecodeFunction(Instruction instruction);
 
 void execute(Instruction *instruction, Registers registers, Memory memory);
 
+void executeInstruction(Instruction instruction, Registers registers, Memory memory);
+
+void run(Registers registers, Memory memory, Engine engine);
+
+StopReason runFor(Registers registers, Memory memory, Engine engine, uint64_t maxInstructions);
+
 #endif // EMULATOR_PROCESS_H
@@ -0,0 +1,21 @@
+///
+/// barrierExecutor.c
+/// Execute a barrier instruction from its intermediate representation (IR)
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "barrierExecutor.h"
+
+/// Executes an [IR] of a barrier instruction.
+/// @param irObject The instruction to execute.
+/// @param registers The current virtual registers.
+/// @param memory The current virtual memory.
+/// @remark Every barrier is a full host fence, whatever its option. An \code isb \endcode run on a view of shared
+/// memory also discards the view's decoded code, so that code written by other cores is fetched afresh.
+void executeBarrier(IR *irObject, unused Registers registers, Memory memory) {
+    assertFatal(irObject->type == BARRIER, "Received non-barrier instruction!");
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (irObject->ir.barrierIR.type == ISB && memory->shared != NULL) discardDecoded(memory);
+}
@@ -0,0 +1,19 @@
+///
+/// barrierExecutor.h
+/// Execute a barrier instruction from its intermediate representation (IR)
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_BARRIER_EXECUTOR_H
+#define EMULATOR_BARRIER_EXECUTOR_H
+
+#include "const.h"
+#include "error.h"
+#include "ir.h"
+#include "memory.h"
+#include "registers.h"
+
+void executeBarrier(IR *irObject, unused Registers registers, Memory memory);
+
+#endif // EMULATOR_BARRIER_EXECUTOR_H
@@ -43,48 +43,8 @@ void executeBranch(IR *irObject, Registers registers, unused Memory memory) {
 
             int64_t pcVal = getRegPC(registers);
 
-            switch (branchIR->data.conditional.condition) {
-                case EQ:
-                    if (getRegState(registers, Z)) {
-                        setRegPC(registers, pcVal + 4 * offset);
-                    }
-                    break;
-
-                case NE:
-                    if (!getRegState(registers, Z)) {
-                        setRegPC(registers, pcVal + 4 * offset);
-                    }
-                    break;
-
-                case GE:
-                    if (getRegState(registers, N) == getRegState(registers, V)) {
-                        setRegPC(registers, pcVal + 4 * offset);
-                    }
-                    break;
-
-                case LT:
-                    if (getRegState(registers, N) != getRegState(registers, V)) {
-                        setRegPC(registers, pcVal + 4 * offset);
-                    }
-                    break;
-
-                case GT:
-                    if (!getRegState(registers, Z)
-                        && getRegState(registers, N) == getRegState(registers, V)) {
-                        setRegPC(registers, pcVal + 4 * offset);
-                    }
-                    break;
-
-                case LE:
-                    if (!(!getRegState(registers, Z)
-                          && getRegState(registers, N) == getRegState(registers, V))) {
-                        setRegPC(registers, pcVal + 4 * offset);
-                    }
-                    break;
-
-                case AL:
-                    setRegPC(registers, pcVal + 4 * offset);
-                    break;
+            if (conditionHolds(branchIR->data.conditional.condition, getRegNZCV(registers))) {
+                setRegPC(registers, pcVal + 4 * offset);
             }
         }
     }
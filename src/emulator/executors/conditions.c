@@ -1,19 +1,42 @@
 ///
 /// conditions.c
-/// Determines whether overflow or underflow has occurred as a result of an arithmetic operation
+/// Determines whether overflow or underflow has occurred as a result of an arithmetic operation, and whether
+/// condition codes hold
 ///
 /// Created by Billy Highley on 06/06/2024.
 ///
 
 #include "conditions.h"
 
+/// The truth table of each condition code, indexed by its encoding. Bit [N << 3 | Z << 2 | C << 1 | V] of an
+/// entry is set iff the condition holds for those flags.
+static const uint16_t truthTable[16] = {
+    [EQ] = 0xF0F0, // Z
+    [NE] = 0x0F0F, // !Z
+    [CS] = 0xCCCC, // C
+    [CC] = 0x3333, // !C
+    [MI] = 0xFF00, // N
+    [PL] = 0x00FF, // !N
+    [VS] = 0xAAAA, // V
+    [VC] = 0x5555, // !V
+    [HI] = 0x0C0C, // C && !Z
+    [LS] = 0xF3F3, // !(C && !Z)
+    [GE] = 0xAA55, // N == V
+    [LT] = 0x55AA, // N != V
+    [GT] = 0x0A05, // !Z && N == V
+    [LE] = 0xF5FA, // !(!Z && N == V)
+    [AL] = 0xFFFF,
+    [NV] = 0xFFFF,
+};
+
 /// Determines whether signed overflow has occurred when performing a 64-bit addition
 /// @param rn The value of the source register
 /// @param op2 The value of the second operand
 /// @param res Result of the addition
 /// @return Whether signed overflow has occurred
 bool overflow64(int64_t rn, int64_t op2, int64_t res) {
-    return (rn > 0 && op2 > 0 && res < 0) || (rn < 0 && op2 < 0 && res > 0);
+    // The operands share a sign which the result does not.
+    return ((rn ^ res) & (op2 ^ res)) < 0;
 }
 
 /// Determines whether signed overflow has occurred when performing a 32-bit addition
@@ -22,7 +45,8 @@ bool overflow64(int64_t rn, int64_t op2, int64_t res) {
 /// @param res Result of the addition
 /// @return Whether signed overflow has occurred
 bool overflow32(int32_t rn, int32_t op2, int32_t res) {
-    return (rn > 0 && op2 > 0 && res < 0) || (rn < 0 && op2 < 0 && res > 0);
+    // The operands share a sign which the result does not.
+    return ((rn ^ res) & (op2 ^ res)) < 0;
 }
 
 /// Determines whether signed underflow has occurred when performing a 64-bit subtraction
@@ -31,7 +55,8 @@ bool overflow32(int32_t rn, int32_t op2, int32_t res) {
 /// @param res Result of the subtraction
 /// @return Whether signed underflow has occurred
 bool underflow64(int64_t rn, int64_t op2, int64_t res) {
-    return (rn > 0 && op2 < 0 && res < 0) || (rn < 0 && op2 > 0 && res > 0);
+    // The operands differ in sign, and the result does not share the sign of [rn].
+    return ((rn ^ op2) & (rn ^ res)) < 0;
 }
 
 /// Determines whether signed underflow has occurred when performing a 32-bit subtraction
@@ -40,5 +65,21 @@ bool underflow64(int64_t rn, int64_t op2, int64_t res) {
 /// @param res Result of the subtraction
 /// @return Whether signed underflow has occurred
 bool underflow32(int32_t rn, int32_t op2, int32_t res) {
-    return (rn > 0 && op2 < 0 && res < 0) || (rn < 0 && op2 > 0 && res > 0);
+    // The operands differ in sign, and the result does not share the sign of [rn].
+    return ((rn ^ op2) & (rn ^ res)) < 0;
+}
+
+/// Gets the truth table of a condition code over packed NZCV.
+/// @param condition The condition code.
+/// @return The 16-bit truth table, whose bit [N << 3 | Z << 2 | C << 1 | V] is set iff [condition] holds.
+uint16_t conditionTruthTable(enum BranchCondition condition) {
+    return truthTable[condition & 0xF];
+}
+
+/// Determines whether a condition code holds for the given flags
+/// @param condition The condition code
+/// @param nzcv The flags, packed as \code N << 3 | Z << 2 | C << 1 | V \endcode
+/// @return Whether [condition] holds
+bool conditionHolds(enum BranchCondition condition, uint8_t nzcv) {
+    return truthTable[condition & 0xF] >> (nzcv & 0xF) & 1;
 }
@@ -1,6 +1,7 @@
 ///
 /// conditions.h
-/// Determines whether overflow or underflow has occurred as a result of an arithmetic operation
+/// Determines whether overflow or underflow has occurred as a result of an arithmetic operation, and whether
+/// condition codes hold
 ///
 /// Created by Billy Highley on 06/06/2024.
 ///
@@ -11,6 +12,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "branch.h"
+
 bool overflow64(int64_t rn, int64_t op2, int64_t res);
 
 bool overflow32(int32_t rn, int32_t op2, int32_t res);
@@ -19,4 +22,24 @@ bool underflow64(int64_t rn, int64_t op2, int64_t res);
 
 bool underflow32(int32_t rn, int32_t op2, int32_t res);
 
+uint16_t conditionTruthTable(enum BranchCondition condition);
+
+bool conditionHolds(enum BranchCondition condition, uint8_t nzcv);
+
+/// Evaluates the flags of a subtraction, for testing a condition straight after it.
+/// @param sf Whether the subtraction was 64-bit.
+/// @param rn The first operand, at the width of the subtraction.
+/// @param op2 The second operand, at the width of the subtraction.
+/// @param res The result, whose bits above the width of the subtraction are ignored.
+/// @returns The flags, as \code N << 3 | Z << 2 | C << 1 | V \endcode.
+/// @remark Defined here so that it is inlined into fused compare-and-branch handlers.
+static inline uint8_t subtractionNZCV(bool sf, uint64_t rn, uint64_t op2, uint64_t res) {
+    unsigned sign = sf ? 63 : 31;
+    uint8_t n = res >> sign & 1;
+    uint8_t z = (sf ? res : (uint32_t) res) == 0;
+    uint8_t c = op2 <= rn;
+    uint8_t v = ((rn ^ op2) & (rn ^ res)) >> sign & 1;
+    return n << 3 | z << 2 | c << 1 | v;
+}
+
 #endif // EMULATOR_CONDITIONS_H
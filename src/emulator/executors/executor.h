@@ -0,0 +1,22 @@
+///
+/// executor.h
+/// The signature shared by every executor.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_EXECUTOR_H
+#define EMULATOR_EXECUTOR_H
+
+#include "ir.h"
+#include "memory.h"
+#include "registers.h"
+
+/// Executes a decoded instruction against the given registers and memory.
+typedef void (*Executor)(IR *irObject, Registers regs, Memory mem);
+
+/// Initialises an array, indexed by [ShiftType], of the executor variants named [__PREFIX__] then each shift.
+#define SHIFT_VARIANTS(__PREFIX__) \
+    { [LSL] = __PREFIX__##LSL, [LSR] = __PREFIX__##LSR, [ASR] = __PREFIX__##ASR, [ROR] = __PREFIX__##ROR }
+
+#endif // EMULATOR_EXECUTOR_H
@@ -0,0 +1,71 @@
+///
+/// compareBranchExecutor.c
+/// Executes a compare fused with the conditional branch which follows it, as a single superinstruction.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "compareBranchExecutor.h"
+
+/// Checks whether [compare] and the [branch] after it can be executed together by [executeCompareBranch].
+/// @param compare The first instruction, which fuses if it is a \code subs \endcode (including \code cmp \endcode).
+/// @param branch The instruction after [compare], which fuses if it is a conditional branch.
+/// @returns Whether the pair fuses.
+bool fusesWithBranch(IR *compare, IR *branch) {
+    if (branch->type != BRANCH || branch->ir.branchIR.type != BRANCH_CONDITIONAL) return false;
+
+    switch (compare->type) {
+        case IMMEDIATE:
+            return compare->ir.immediateIR.opi == IMMEDIATE_ARITHMETIC
+                   && compare->ir.immediateIR.opc.arithmeticType == SUBS;
+
+        case REGISTER:
+            return compare->ir.registerIR.group == ARITHMETIC && compare->ir.registerIR.opc.arithmetic == SUBS;
+
+        default:
+            return false;
+    }
+}
+
+/// Executes a fused compare and conditional branch, leaving the PC at the branch's successor.
+/// @param compare The \code subs \endcode, at the current PC.
+/// @param branch The conditional branch immediately after [compare].
+/// @param registers The current virtual registers.
+/// @pre [fusesWithBranch] holds for [compare] and [branch].
+/// @remark The flags are still recorded for later readers, but the branch tests the subtraction directly rather
+/// than evaluating them back out of [Registers_s.flags].
+void executeCompareBranch(IR *compare, IR *branch, Registers registers) {
+    bool sf;
+    uint8_t rd;
+    uint64_t rn;
+    uint64_t op2;
+
+    if (compare->type == IMMEDIATE) {
+        Immediate_IR *immediateIR = &compare->ir.immediateIR;
+        struct Arithmetic *operand = &immediateIR->operand.arithmetic;
+        sf = immediateIR->sf;
+        rd = immediateIR->rd;
+        rn = getReg(registers, operand->rn);
+        op2 = (uint32_t) operand->imm12 << (operand->sh * 12);
+    } else {
+        Register_IR *registerIR = &compare->ir.registerIR;
+        sf = registerIR->sf;
+        rd = registerIR->rd;
+        rn = getReg(registers, registerIR->rn);
+        uint64_t rm = getReg(registers, registerIR->rm);
+        op2 = bitShift(registerIR->shift, registerIR->operand.imm6, sf ? rm : (uint32_t) rm, sf);
+    }
+    rn = sf ? rn : (uint32_t) rn;
+
+    uint64_t res = rn - op2;
+    setRegFlags(registers, FLAGS_SUB, sf, rn, op2, res);
+    setReg(registers, rd, sf, res);
+
+    // As in [executeBranch], relative to the branch; and as in [execute], a branch to itself falls through.
+    BitData branchAddress = getRegPC(registers) + WORD_SIZE;
+    int64_t simm19 = branch->ir.branchIR.data.conditional.simm19.data.immediate;
+    int64_t offset = signExtend(simm19, 8 * sizeof(uint32_t));
+
+    bool taken = conditionHolds(branch->ir.branchIR.data.conditional.condition, subtractionNZCV(sf, rn, op2, res));
+    setRegPC(registers, taken && offset != 0 ? branchAddress + 4 * offset : branchAddress + WORD_SIZE);
+}
@@ -0,0 +1,26 @@
+///
+/// compareBranchExecutor.h
+/// Executes a compare fused with the conditional branch which follows it, as a single superinstruction.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_COMPARE_BRANCH_EXECUTOR_H
+#define EMULATOR_COMPARE_BRANCH_EXECUTOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bitwiseShifts.h"
+#include "conditions.h"
+#include "const.h"
+#include "error.h"
+#include "ir.h"
+#include "memory.h"
+#include "registers.h"
+
+bool fusesWithBranch(IR *compare, IR *branch);
+
+void executeCompareBranch(IR *compare, IR *branch, Registers registers);
+
+#endif // EMULATOR_COMPARE_BRANCH_EXECUTOR_H
@@ -7,36 +7,34 @@
 
 #include "arithmeticImmediateExecutor.h"
 
-/// Executes an [IR] of a data processing (immediate, arithmetic) instruction.
+/// Executes an [IR] of a data processing (immediate, arithmetic) instruction, as [type] at [sf] width.
 /// @param immediateIR The instruction to execute.
 /// @param registers The current virtual registers.
-void arithmeticExecute(Immediate_IR *immediateIR, Registers registers) {
+/// @param type The arithmetic operation of [immediateIR].
+/// @param sf Whether [immediateIR] is 64-bit.
+/// @remark Inlined into each variant, where constant [type] and [sf] let the compiler fold away the checks.
+static inline void arithmetic(Immediate_IR *immediateIR, Registers registers, enum ArithmeticType type, bool sf) {
     // Operand interpreted as an arithmetic type instruction
     struct Arithmetic *operand = &immediateIR->operand.arithmetic;
 
     // Set rn value to the 64-bit or 32-bit value of the source register, determined by sf
     uint64_t rn = getReg(registers, operand->rn);
-    rn = immediateIR->sf ? rn : (uint32_t) rn;
+    rn = sf ? rn : (uint32_t) rn;
 
     // [imm12] is left-shifted by 12 if [sh] is true.
     uint32_t op2 = operand->imm12 << (operand->sh * 12);
 
     uint64_t res;
-    PState pState;
 
     // Determine the type of arithmetic instruction
-    switch (immediateIR->opc.arithmeticType) {
+    switch (type) {
         case ADD:
             res = rn + op2;
             break;
 
         case ADDS:
             res = rn + op2;
-            pState.ng = immediateIR->sf ? res > INT64_MAX : (uint32_t) res > INT32_MAX;
-            pState.zr = res == 0;
-            pState.cr = immediateIR->sf ? op2 > UINT64_MAX - rn : op2 > UINT32_MAX - rn;
-            pState.ov = immediateIR->sf ? overflow64(rn, op2, res) : overflow32(rn, op2, res);
-            setRegStates(registers, pState);
+            setRegFlags(registers, FLAGS_ADD, sf, rn, op2, res);
             break;
 
         case SUB:
@@ -45,14 +43,50 @@ void arithmeticExecute(Immediate_IR *immediateIR, Registers registers) {
 
         case SUBS:
             res = rn - op2;
-            pState.ng = immediateIR->sf ? res > INT64_MAX : (uint32_t) res > INT32_MAX;
-            pState.zr = res == 0;
-            pState.cr = op2 <= rn;
-            pState.ov = immediateIR->sf ? underflow64(rn, op2, res) : underflow32(rn, op2, res);
-            setRegStates(registers, pState);
+            setRegFlags(registers, FLAGS_SUB, sf, rn, op2, res);
             break;
+
+        default:
+            throwFatal("Unrecognised arithmetic type!");
     }
 
     // Set destination register to the result value, accessed in either 64-bit or 32-bit mode determined by sf
-    setReg(registers, immediateIR->rd, immediateIR->sf, res);
+    setReg(registers, immediateIR->rd, sf, res);
+}
+
+/// Executes an [IR] of a data processing (immediate, arithmetic) instruction.
+/// @param immediateIR The instruction to execute.
+/// @param registers The current virtual registers.
+void arithmeticExecute(Immediate_IR *immediateIR, Registers registers) {
+    arithmetic(immediateIR, registers, immediateIR->opc.arithmeticType, immediateIR->sf);
+}
+
+/// Defines the executor of [__TYPE__] (immediate) at [__WIDTH__] bits.
+#define ARITHMETIC_IMMEDIATE_VARIANT(__TYPE__, __WIDTH__) \
+    static void execute##__TYPE__##Immediate##__WIDTH__(IR *irObject, Registers registers, unused Memory memory) { \
+        arithmetic(&irObject->ir.immediateIR, registers, __TYPE__, __WIDTH__ == 64); \
+    }
+
+ARITHMETIC_IMMEDIATE_VARIANT(ADD, 32)
+ARITHMETIC_IMMEDIATE_VARIANT(ADD, 64)
+ARITHMETIC_IMMEDIATE_VARIANT(ADDS, 32)
+ARITHMETIC_IMMEDIATE_VARIANT(ADDS, 64)
+ARITHMETIC_IMMEDIATE_VARIANT(SUB, 32)
+ARITHMETIC_IMMEDIATE_VARIANT(SUB, 64)
+ARITHMETIC_IMMEDIATE_VARIANT(SUBS, 32)
+ARITHMETIC_IMMEDIATE_VARIANT(SUBS, 64)
+
+/// Gets the executor specialised for the operation and width of a data processing (immediate, arithmetic)
+/// instruction.
+/// @param immediateIR The instruction.
+/// @returns The specialised [Executor].
+Executor arithmeticImmediateVariant(Immediate_IR *immediateIR) {
+    static const Executor variants[][2] = {
+        [ADD] = { executeADDImmediate32, executeADDImmediate64 },
+        [ADDS] = { executeADDSImmediate32, executeADDSImmediate64 },
+        [SUB] = { executeSUBImmediate32, executeSUBImmediate64 },
+        [SUBS] = { executeSUBSImmediate32, executeSUBSImmediate64 },
+    };
+
+    return variants[immediateIR->opc.arithmeticType][immediateIR->sf];
 }
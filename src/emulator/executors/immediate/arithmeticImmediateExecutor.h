@@ -8,13 +8,15 @@
 #ifndef EMULATOR_ARITHMETIC_IMMEDIATE_EXECUTOR_H
 #define EMULATOR_ARITHMETIC_IMMEDIATE_EXECUTOR_H
 
-#include "conditions.h"
 #include "const.h"
 #include "error.h"
+#include "executor.h"
 #include "ir.h"
 #include "memory.h"
 #include "registers.h"
 
 void arithmeticExecute(Immediate_IR *immediateIR, Registers registers);
 
+Executor arithmeticImmediateVariant(Immediate_IR *immediateIR);
+
 #endif // EMULATOR_ARITHMETIC_IMMEDIATE_EXECUTOR_H
@@ -21,3 +21,13 @@ void executeImmediate(IR *irObject, Registers registers, unused Memory memory) {
     ? arithmeticExecute(immediateIR, registers)
     : wideMoveExecute(immediateIR, registers);
 }
+
+/// Gets the executor specialised for a data processing (immediate) instruction, so that execution need not
+/// re-examine its type, operation, or width.
+/// @param immediateIR The instruction.
+/// @returns The specialised [Executor].
+Executor immediateVariant(Immediate_IR *immediateIR) {
+    return immediateIR->opi == IMMEDIATE_ARITHMETIC
+           ? arithmeticImmediateVariant(immediateIR)
+           : wideMoveVariant(immediateIR);
+}
@@ -11,6 +11,7 @@
 #include "arithmeticImmediateExecutor.h"
 #include "const.h"
 #include "error.h"
+#include "executor.h"
 #include "ir.h"
 #include "memory.h"
 #include "registers.h"
@@ -18,4 +19,6 @@
 
 void executeImmediate(IR *irObject, Registers registers, unused Memory memory);
 
+Executor immediateVariant(Immediate_IR *immediateIR);
+
 #endif // EMULATOR_IMMEDIATE_EXECUTOR_H
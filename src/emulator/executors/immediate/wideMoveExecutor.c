@@ -7,22 +7,25 @@
 
 #include "wideMoveExecutor.h"
 
-/// Executes an [IR] of a data processing (immediate, wide move) instruction.
+/// Executes an [IR] of a data processing (immediate, wide move) instruction, as [type] at [sf] width.
 /// @param immediateIR The instruction to execute.
 /// @param registers The current virtual registers.
-void wideMoveExecute(Immediate_IR *immediateIR, Registers registers) {
+/// @param type The wide move operation of [immediateIR].
+/// @param sf Whether [immediateIR] is 64-bit.
+/// @remark Inlined into each variant, where constant [type] and [sf] let the compiler fold away the checks.
+static inline void wideMove(Immediate_IR *immediateIR, Registers registers, enum WideMoveType type, bool sf) {
     struct WideMove *operand = &immediateIR->operand.wideMove;
 
     // Retrieve rd value as a 64-bit or 32-bit value from the destination register, determined by sf
     uint64_t rd = getReg(registers, immediateIR->rd);
-    rd = immediateIR->sf ? rd : (uint32_t) rd;
+    rd = sf ? rd : (uint32_t) rd;
 
     // Op is imm16 shifted left by either 0, 16, 32 or 48 bits, determined by hw
     uint64_t op = (uint64_t) operand->imm16 << (operand->hw * 16);
     uint64_t res;
 
     // Determine the type of wide move instruction
-    switch (immediateIR->opc.wideMoveType) {
+    switch (type) {
         // Move wide with NOT
         case MOVN:
             res = ~op;
@@ -37,7 +40,44 @@ void wideMoveExecute(Immediate_IR *immediateIR, Registers registers) {
         case MOVK:
             res = op | (rd & ~((uint64_t) UINT16_MAX << (operand->hw * 16)));
             break;
+
+        default:
+            throwFatal("Unrecognised wide move type!");
     }
 
-    setReg(registers, immediateIR->rd, immediateIR->sf, res);
+    setReg(registers, immediateIR->rd, sf, res);
+}
+
+/// Executes an [IR] of a data processing (immediate, wide move) instruction.
+/// @param immediateIR The instruction to execute.
+/// @param registers The current virtual registers.
+void wideMoveExecute(Immediate_IR *immediateIR, Registers registers) {
+    wideMove(immediateIR, registers, immediateIR->opc.wideMoveType, immediateIR->sf);
+}
+
+/// Defines the executor of [__TYPE__] at [__WIDTH__] bits.
+#define WIDE_MOVE_VARIANT(__TYPE__, __WIDTH__) \
+    static void execute##__TYPE__##__WIDTH__(IR *irObject, Registers registers, unused Memory memory) { \
+        wideMove(&irObject->ir.immediateIR, registers, __TYPE__, __WIDTH__ == 64); \
+    }
+
+WIDE_MOVE_VARIANT(MOVN, 32)
+WIDE_MOVE_VARIANT(MOVN, 64)
+WIDE_MOVE_VARIANT(MOVZ, 32)
+WIDE_MOVE_VARIANT(MOVZ, 64)
+WIDE_MOVE_VARIANT(MOVK, 32)
+WIDE_MOVE_VARIANT(MOVK, 64)
+
+/// Gets the executor specialised for the operation and width of a data processing (immediate, wide move)
+/// instruction.
+/// @param immediateIR The instruction.
+/// @returns The specialised [Executor].
+Executor wideMoveVariant(Immediate_IR *immediateIR) {
+    static const Executor variants[][2] = {
+        [MOVN] = { executeMOVN32, executeMOVN64 },
+        [MOVZ] = { executeMOVZ32, executeMOVZ64 },
+        [MOVK] = { executeMOVK32, executeMOVK64 },
+    };
+
+    return variants[immediateIR->opc.wideMoveType][immediateIR->sf];
 }
@@ -10,10 +10,13 @@
 
 #include "const.h"
 #include "error.h"
+#include "executor.h"
 #include "ir.h"
 #include "memory.h"
 #include "registers.h"
 
 void wideMoveExecute(Immediate_IR *immediateIR, Registers regs);
 
+Executor wideMoveVariant(Immediate_IR *immediateIR);
+
 #endif // EMULATOR_WIDE_MOVE_EXECUTOR_H
@@ -7,6 +7,8 @@
 
 #include "loadStoreExecutor.h"
 
+static void executeExclusive(LoadStore_IR *loadStoreIR, Registers registers, Memory memory);
+
 /// Executes an [IR] of a data processing (immediate) instruction.
 /// @param immediateIR The instruction to execute.
 /// @param registers The current virtual registers.
@@ -73,6 +75,10 @@ void executeLoadStore(IR *irObject, Registers registers, Memory memory) {
             int64_t simm19Extended = signExtend(simm19, 8 * sizeof(uint32_t));
             transferAddress += simm19Extended * 4;
             break;
+
+        case LOAD_STORE_EXCLUSIVE:
+            executeExclusive(loadStoreIR, registers, memory);
+            return;
     }
 
     if (isLoad) {
@@ -88,3 +94,37 @@ void executeLoadStore(IR *irObject, Registers registers, Memory memory) {
         setReg(registers, loadStoreIR->data.sdt.xn, true, writeBackValue);
     }
 }
+
+/// Executes a load/store exclusive instruction.
+/// @param loadStoreIR The instruction to execute.
+/// @param registers The current virtual registers.
+/// @param memory The current virtual memory.
+/// @remark The exclusive monitor remembers the value a load exclusive read, and the store exclusive only commits
+/// if memory still holds it, as one atomic compare-and-exchange. So a store from any other core in between fails
+/// it, short of one which puts the very same value back.
+static void executeExclusive(LoadStore_IR *loadStoreIR, Registers registers, Memory memory) {
+    struct Exclusive *exclusive = &loadStoreIR->data.exclusive;
+    BitData transferAddress = getReg(registers, exclusive->xn);
+    assertFatal(transferAddress % (loadStoreIR->sf ? 8 : 4) == 0, "Received misaligned exclusive access!");
+
+    if (exclusive->l) {
+        BitData value = readMem(memory, loadStoreIR->sf, transferAddress);
+        if (exclusive->ordered) __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        setReg(registers, loadStoreIR->rt, loadStoreIR->sf, value);
+        registers->exclusive = true;
+        registers->exclusiveAddress = transferAddress;
+        registers->exclusiveValue = value;
+        return;
+    }
+
+    if (exclusive->ordered) __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    bool stored = registers->exclusive && registers->exclusiveAddress == transferAddress
+                  && exchangeMem(memory, loadStoreIR->sf, transferAddress, registers->exclusiveValue,
+                                 getReg(registers, loadStoreIR->rt));
+
+    // The monitor is cleared by any store exclusive, whether or not it succeeded.
+    registers->exclusive = false;
+    setReg(registers, exclusive->rs, false, stored ? 0 : 1);
+}
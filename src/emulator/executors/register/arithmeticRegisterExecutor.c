@@ -7,28 +7,33 @@
 
 #include "arithmeticRegisterExecutor.h"
 
-/// Executes an [IR] of a data processing (register, arithmetic) instruction.
+/// Executes an [IR] of a data processing (register, arithmetic) instruction, as [type] at [sf] width with [shift].
 /// @param registerIR The instruction to execute.
 /// @param registers The current virtual registers.
-void arithmeticRegisterExecute(Register_IR *registerIR, Registers registers) {
+/// @param type The arithmetic operation of [registerIR].
+/// @param sf Whether [registerIR] is 64-bit.
+/// @param shift The shift applied to rm.
+/// @remark Inlined into each variant, where constant [type], [sf] and [shift] let the compiler fold away the
+/// checks.
+static inline void arithmeticRegister(Register_IR *registerIR, Registers registers,
+                                      enum ArithmeticType type, bool sf, enum ShiftType shift) {
     // Operand interpreted as an arithmetic type instruction
     uint8_t operand = registerIR->operand.imm6;
 
     // Set rn value to the 64-bit or 32-bit value of the operand register, determined by sf
     uint64_t rm = getReg(registers, registerIR->rm);
-    rm = registerIR->sf ? rm : (uint32_t) rm;
+    rm = sf ? rm : (uint32_t) rm;
 
     // Set rn value to the 64-bit or 32-bit value of the source register, determined by sf
     uint64_t rn = getReg(registers, registerIR->rn);
-    rn = registerIR->sf ? rn : (uint32_t) rn;
+    rn = sf ? rn : (uint32_t) rn;
 
     // Op2 is rm shifted by operand many bits by the encoded shift
-    uint64_t op2 = bitShift(registerIR->shift, operand, rm, registerIR->sf);
+    uint64_t op2 = bitShift(shift, operand, rm, sf);
 
     uint64_t res;
-    PState pState;
 
-    switch (registerIR->opc.arithmetic) {
+    switch (type) {
         // Add
         case ADD:
             res = rn + op2;
@@ -37,11 +42,7 @@ void arithmeticRegisterExecute(Register_IR *registerIR, Registers registers) {
         // Add (and set flags)
         case ADDS:
             res = rn + op2;
-            pState.ng = registerIR->sf ? res > INT64_MAX : (uint32_t) res > INT32_MAX;
-            pState.zr = res == 0;
-            pState.cr = registerIR->sf ? op2 > UINT64_MAX - rn : op2 > UINT32_MAX - rn;
-            pState.ov = registerIR->sf ? overflow64(rn, op2, res) : overflow32(rn, op2, res);
-            setRegStates(registers, pState);
+            setRegFlags(registers, FLAGS_ADD, sf, rn, op2, res);
             break;
 
         // Subtract
@@ -52,14 +53,62 @@ void arithmeticRegisterExecute(Register_IR *registerIR, Registers registers) {
         // Subtract (and set flags)
         case SUBS:
             res = rn - op2;
-            pState.ng = registerIR->sf ? res > INT64_MAX : (uint32_t) res > INT32_MAX;
-            pState.zr = res == 0;
-            pState.cr = op2 <= rn;
-            pState.ov = registerIR->sf ? underflow64(rn, op2, res) : underflow32(rn, op2, res);
-            setRegStates(registers, pState);
+            setRegFlags(registers, FLAGS_SUB, sf, rn, op2, res);
             break;
+
+        default:
+            throwFatal("Unrecognised arithmetic type!");
     }
 
     // Set destination register to the result value, accessed in either 64-bit or 32-bit mode determined by sf
-    setReg(registers, registerIR->rd, registerIR->sf, res);
+    setReg(registers, registerIR->rd, sf, res);
+}
+
+/// Executes an [IR] of a data processing (register, arithmetic) instruction.
+/// @param registerIR The instruction to execute.
+/// @param registers The current virtual registers.
+void arithmeticRegisterExecute(Register_IR *registerIR, Registers registers) {
+    arithmeticRegister(registerIR, registers, registerIR->opc.arithmetic, registerIR->sf, registerIR->shift);
+}
+
+/// Defines the executor of [__TYPE__] (register) at [__WIDTH__] bits, with [__SHIFT__].
+#define ARITHMETIC_REGISTER_VARIANT(__TYPE__, __WIDTH__, __SHIFT__) \
+    static void execute##__TYPE__##Register##__WIDTH__##__SHIFT__(IR *irObject, Registers registers, \
+                                                                  unused Memory memory) { \
+        arithmeticRegister(&irObject->ir.registerIR, registers, __TYPE__, __WIDTH__ == 64, __SHIFT__); \
+    }
+
+/// Defines the executors of [__TYPE__] (register), at every width and with every shift.
+#define ARITHMETIC_REGISTER_VARIANTS(__TYPE__) \
+    ARITHMETIC_REGISTER_VARIANT(__TYPE__, 32, LSL) \
+    ARITHMETIC_REGISTER_VARIANT(__TYPE__, 32, LSR) \
+    ARITHMETIC_REGISTER_VARIANT(__TYPE__, 32, ASR) \
+    ARITHMETIC_REGISTER_VARIANT(__TYPE__, 32, ROR) \
+    ARITHMETIC_REGISTER_VARIANT(__TYPE__, 64, LSL) \
+    ARITHMETIC_REGISTER_VARIANT(__TYPE__, 64, LSR) \
+    ARITHMETIC_REGISTER_VARIANT(__TYPE__, 64, ASR) \
+    ARITHMETIC_REGISTER_VARIANT(__TYPE__, 64, ROR)
+
+ARITHMETIC_REGISTER_VARIANTS(ADD)
+ARITHMETIC_REGISTER_VARIANTS(ADDS)
+ARITHMETIC_REGISTER_VARIANTS(SUB)
+ARITHMETIC_REGISTER_VARIANTS(SUBS)
+
+/// The executors of [__TYPE__] (register) at 32 and 64 bits, indexed by shift.
+#define ARITHMETIC_REGISTER_ROW(__TYPE__) \
+    { SHIFT_VARIANTS(execute##__TYPE__##Register32), SHIFT_VARIANTS(execute##__TYPE__##Register64) }
+
+/// Gets the executor specialised for the operation, width, and shift of a data processing (register, arithmetic)
+/// instruction.
+/// @param registerIR The instruction.
+/// @returns The specialised [Executor].
+Executor arithmeticRegisterVariant(Register_IR *registerIR) {
+    static const Executor variants[][2][4] = {
+        [ADD] = ARITHMETIC_REGISTER_ROW(ADD),
+        [ADDS] = ARITHMETIC_REGISTER_ROW(ADDS),
+        [SUB] = ARITHMETIC_REGISTER_ROW(SUB),
+        [SUBS] = ARITHMETIC_REGISTER_ROW(SUBS),
+    };
+
+    return variants[registerIR->opc.arithmetic][registerIR->sf][registerIR->shift];
 }
@@ -9,10 +9,12 @@
 #define EMULATOR_ARITHMETIC_REGISTER_EXECUTOR_H
 
 #include "bitwiseShifts.h"
-#include "conditions.h"
+#include "executor.h"
 #include "register.h"
 #include "registers.h"
 
 void arithmeticRegisterExecute(Register_IR *registerIR, Registers registers);
 
+Executor arithmeticRegisterVariant(Register_IR *registerIR);
+
 #endif // EMULATOR_ARITHMETIC_REGISTER_EXECUTOR_H
@@ -7,33 +7,37 @@
 
 #include "bitLogicExecutor.h"
 
-static PState determinePState(bool sf, uint64_t res);
-
-/// Executes an [IR] of a data processing (register, arithmetic) instruction.
+/// Executes an [IR] of a data processing (register, bit-logic) instruction, as [opcode] at [sf] width with [shift].
 /// @param registerIR The instruction to execute.
 /// @param registers The current virtual registers.
-void bitLogicExecute(Register_IR *registerIR, Registers registers) {
-
+/// @param negated Whether [registerIR] is a negated bit-logic operation.
+/// @param opcode The bit-logic operation of [registerIR], a [StandardType] or [NegatedType] as per [negated].
+/// @param sf Whether [registerIR] is 64-bit.
+/// @param shift The shift applied to rm.
+/// @remark Inlined into each variant, where constant [negated], [opcode], [sf] and [shift] let the compiler fold
+/// away the checks.
+static inline void bitLogic(Register_IR *registerIR, Registers registers,
+                            bool negated, uint8_t opcode, bool sf, enum ShiftType shift) {
     // Operand interpreted as a bit-logic type instruction
     uint8_t operand = registerIR->operand.imm6;
 
     // Get value of register encoded by rm
     uint64_t rm = getReg(registers, registerIR->rm);
-    rm = registerIR->sf ? rm : (uint32_t) rm;
+    rm = sf ? rm : (uint32_t) rm;
 
     // Set rn value to the 64-bit or 32-bit value of the source register, determined by sf
     uint64_t rn = getReg(registers, registerIR->rn);
-    rn = registerIR->sf ? rn : (uint32_t) rn;
+    rn = sf ? rn : (uint32_t) rn;
 
     // Op2 is rm shifted by operand many bits by the encoded shift
-    uint64_t op2 = bitShift(registerIR->shift, operand, rm, registerIR->sf);
+    uint64_t op2 = bitShift(shift, operand, rm, sf);
 
     // Initialise result value
     uint64_t res;
 
-    if (!registerIR->negated) {
+    if (!negated) {
         // Standard operation.
-        switch (registerIR->opc.logic.standard) {
+        switch ((enum StandardType) opcode) {
             case AND:
                 res = rn & op2;
                 break;
@@ -49,12 +53,15 @@ void bitLogicExecute(Register_IR *registerIR, Registers registers) {
             case ANDS:
                 // AND (and set flags)
                 res = rn & op2;
-                setRegStates(registers, determinePState(registerIR->sf, res));
+                setRegFlags(registers, FLAGS_LOGIC, sf, rn, op2, res);
                 break;
+
+            default:
+                throwFatal("Unrecognised bit-logic type!");
         }
     } else {
         // Negated operation.
-        switch (registerIR->opc.logic.negated) {
+        switch ((enum NegatedType) opcode) {
             case BIC:
                 res = rn & ~op2;
                 break; // Bit clear
@@ -70,26 +77,75 @@ void bitLogicExecute(Register_IR *registerIR, Registers registers) {
             case BICS:
                 // Bit clear (and set flags)
                 res = rn & ~op2;
-                setRegStates(registers, determinePState(registerIR->sf, res));
+                setRegFlags(registers, FLAGS_LOGIC, sf, rn, op2, res);
                 break;
+
+            default:
+                throwFatal("Unrecognised bit-logic type!");
         }
     }
 
     // Set destination register to the result value, accessed in either 64-bit or 32-bit mode determined by sf
-    setReg(registers, registerIR->rd, registerIR->sf, res);
+    setReg(registers, registerIR->rd, sf, res);
 }
 
-/// Determines [PState] given a calculation result.
-/// @param sf The bit-width of the register.
-/// @param res The calculation result.
-/// @returns The resulting [PState].
-static PState determinePState(bool sf, uint64_t res) {
-    PState pState;
+/// Executes an [IR] of a data processing (register, bit-logic) instruction.
+/// @param registerIR The instruction to execute.
+/// @param registers The current virtual registers.
+void bitLogicExecute(Register_IR *registerIR, Registers registers) {
+    bitLogic(registerIR, registers, registerIR->negated, registerIR->opc.logic.standard, registerIR->sf,
+             registerIR->shift);
+}
 
-    pState.ng = sf ? res > INT64_MAX : res > INT32_MAX;
-    pState.zr = res == 0;
-    pState.cr = 0;
-    pState.ov = 0;
+/// Defines the executor of [__OPCODE__] at [__WIDTH__] bits, with [__SHIFT__].
+#define BIT_LOGIC_VARIANT(__OPCODE__, __NEGATED__, __WIDTH__, __SHIFT__) \
+    static void execute##__OPCODE__##__WIDTH__##__SHIFT__(IR *irObject, Registers registers, \
+                                                          unused Memory memory) { \
+        bitLogic(&irObject->ir.registerIR, registers, __NEGATED__, __OPCODE__, __WIDTH__ == 64, __SHIFT__); \
+    }
 
-    return pState;
+/// Defines the executors of [__OPCODE__], at every width and with every shift.
+#define BIT_LOGIC_VARIANTS(__OPCODE__, __NEGATED__) \
+    BIT_LOGIC_VARIANT(__OPCODE__, __NEGATED__, 32, LSL) \
+    BIT_LOGIC_VARIANT(__OPCODE__, __NEGATED__, 32, LSR) \
+    BIT_LOGIC_VARIANT(__OPCODE__, __NEGATED__, 32, ASR) \
+    BIT_LOGIC_VARIANT(__OPCODE__, __NEGATED__, 32, ROR) \
+    BIT_LOGIC_VARIANT(__OPCODE__, __NEGATED__, 64, LSL) \
+    BIT_LOGIC_VARIANT(__OPCODE__, __NEGATED__, 64, LSR) \
+    BIT_LOGIC_VARIANT(__OPCODE__, __NEGATED__, 64, ASR) \
+    BIT_LOGIC_VARIANT(__OPCODE__, __NEGATED__, 64, ROR)
+
+BIT_LOGIC_VARIANTS(AND, false)
+BIT_LOGIC_VARIANTS(ORR, false)
+BIT_LOGIC_VARIANTS(EOR, false)
+BIT_LOGIC_VARIANTS(ANDS, false)
+BIT_LOGIC_VARIANTS(BIC, true)
+BIT_LOGIC_VARIANTS(ORN, true)
+BIT_LOGIC_VARIANTS(EON, true)
+BIT_LOGIC_VARIANTS(BICS, true)
+
+/// The executors of [__OPCODE__] at 32 and 64 bits, indexed by shift.
+#define BIT_LOGIC_ROW(__OPCODE__) { SHIFT_VARIANTS(execute##__OPCODE__##32), SHIFT_VARIANTS(execute##__OPCODE__##64) }
+
+/// Gets the executor specialised for the operation, width, and shift of a data processing (register, bit-logic)
+/// instruction.
+/// @param registerIR The instruction.
+/// @returns The specialised [Executor].
+Executor bitLogicVariant(Register_IR *registerIR) {
+    static const Executor variants[2][4][2][4] = {
+        [false] = {
+            [AND] = BIT_LOGIC_ROW(AND),
+            [ORR] = BIT_LOGIC_ROW(ORR),
+            [EOR] = BIT_LOGIC_ROW(EOR),
+            [ANDS] = BIT_LOGIC_ROW(ANDS),
+        },
+        [true] = {
+            [BIC] = BIT_LOGIC_ROW(BIC),
+            [ORN] = BIT_LOGIC_ROW(ORN),
+            [EON] = BIT_LOGIC_ROW(EON),
+            [BICS] = BIT_LOGIC_ROW(BICS),
+        },
+    };
+
+    return variants[registerIR->negated][registerIR->opc.logic.standard][registerIR->sf][registerIR->shift];
 }
@@ -9,9 +9,12 @@
 #define EMULATOR_BIT_LOGIC_EXECUTOR_H
 
 #include "bitwiseShifts.h"
+#include "executor.h"
 #include "register.h"
 #include "registers.h"
 
 void bitLogicExecute(Register_IR *registerIR, Registers registers);
 
+Executor bitLogicVariant(Register_IR *registerIR);
+
 #endif // EMULATOR_BIT_LOGIC_EXECUTOR_H
@@ -7,28 +7,61 @@
 
 #include "multiplyExecutor.h"
 
-/// Execute a multiply type instruction
+/// Execute a multiply type instruction, subtracting the product if [x], at [sf] width.
 /// @param regIR IR for a register (multiply) instruction
 /// @param regs Pointer to registers
-void multiplyExecute(Register_IR *registerIR, Registers regs) {
+/// @param x Whether to subtract, rather than add, the product.
+/// @param sf Whether [registerIR] is 64-bit.
+/// @remark Inlined into each variant, where constant [x] and [sf] let the compiler fold away the checks.
+static inline void multiply(Register_IR *registerIR, Registers regs, bool x, bool sf) {
     // Set ra value to the 64-bit or 32-bit value of the ra-encoded register, determined by sf
     uint64_t ra = getReg(regs, registerIR->operand.multiply.ra);
-    ra = registerIR->sf ? ra : (uint32_t) ra;
+    ra = sf ? ra : (uint32_t) ra;
 
     // Set rn value to the 64-bit or 32-bit value of the rn-encoded register, determined by sf
     uint64_t rn = getReg(regs, registerIR->rn);
-    rn = registerIR->sf ? rn : (uint32_t) rn;
+    rn = sf ? rn : (uint32_t) rn;
 
     // Set rm value to the 64-bit or 32-bit value of the rm-encoded register, determined by sf
     uint64_t rm = getReg(regs, registerIR->rm);
-    rm = registerIR->sf ? rm : (uint32_t) rm;
+    rm = sf ? rm : (uint32_t) rm;
 
     // Initialise result value
     uint64_t res;
 
     // Perform multiply-add or multiply-sub depending on the value of x
-    registerIR->operand.multiply.x ? (res = ra - rn * rm) : (res = ra + rn * rm);
+    x ? (res = ra - rn * rm) : (res = ra + rn * rm);
 
     // Set destination register to the result value, accessed in either 64-bit or 32-bit mode determined by sf
-    setReg(regs, registerIR->rd, registerIR->sf, res);
+    setReg(regs, registerIR->rd, sf, res);
+}
+
+/// Execute a multiply type instruction
+/// @param regIR IR for a register (multiply) instruction
+/// @param regs Pointer to registers
+void multiplyExecute(Register_IR *registerIR, Registers regs) {
+    multiply(registerIR, regs, registerIR->operand.multiply.x, registerIR->sf);
+}
+
+/// Defines the executor of [__TYPE__] at [__WIDTH__] bits.
+#define MULTIPLY_VARIANT(__TYPE__, __WIDTH__) \
+    static void execute##__TYPE__##__WIDTH__(IR *irObject, Registers registers, unused Memory memory) { \
+        multiply(&irObject->ir.registerIR, registers, __TYPE__ == MSUB, __WIDTH__ == 64); \
+    }
+
+MULTIPLY_VARIANT(MADD, 32)
+MULTIPLY_VARIANT(MADD, 64)
+MULTIPLY_VARIANT(MSUB, 32)
+MULTIPLY_VARIANT(MSUB, 64)
+
+/// Gets the executor specialised for the operation and width of a multiply instruction.
+/// @param registerIR The instruction.
+/// @returns The specialised [Executor].
+Executor multiplyVariant(Register_IR *registerIR) {
+    static const Executor variants[][2] = {
+        [MADD] = { executeMADD32, executeMADD64 },
+        [MSUB] = { executeMSUB32, executeMSUB64 },
+    };
+
+    return variants[registerIR->operand.multiply.x][registerIR->sf];
 }
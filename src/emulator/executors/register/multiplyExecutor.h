@@ -8,9 +8,12 @@
 #ifndef EMULATOR_MULTIPLY_EXECUTOR_H
 #define EMULATOR_MULTIPLY_EXECUTOR_H
 
+#include "executor.h"
 #include "register.h"
 #include "registers.h"
 
 void multiplyExecute(Register_IR *registerIR, Registers regs);
 
+Executor multiplyVariant(Register_IR *registerIR);
+
 #endif // EMULATOR_MULTIPLY_EXECUTOR_H
@@ -30,3 +30,25 @@ void executeRegister(IR *irObject, Registers registers, unused Memory memory) {
             break;
     }
 }
+
+/// Gets the executor specialised for a data processing (register) instruction, so that execution need not
+/// re-examine its group, operation, width, or shift.
+/// @param registerIR The instruction.
+/// @returns The specialised [Executor].
+/// @remark 32-bit operations with a (reserved) shift of 32 or more are left to [executeRegister].
+Executor registerVariant(Register_IR *registerIR) {
+    switch (registerIR->group) {
+        case ARITHMETIC:
+            if (!registerIR->sf && registerIR->operand.imm6 >= 32) return executeRegister;
+            return arithmeticRegisterVariant(registerIR);
+
+        case BIT_LOGIC:
+            if (!registerIR->sf && registerIR->operand.imm6 >= 32) return executeRegister;
+            return bitLogicVariant(registerIR);
+
+        case MULTIPLY:
+            return multiplyVariant(registerIR);
+    }
+
+    return executeRegister;
+}
@@ -12,6 +12,7 @@
 #include "bitLogicExecutor.h"
 #include "const.h"
 #include "error.h"
+#include "executor.h"
 #include "ir.h"
 #include "memory.h"
 #include "multiplyExecutor.h"
@@ -19,4 +20,6 @@
 
 void executeRegister(IR *irObject, Registers registers, unused Memory memory);
 
+Executor registerVariant(Register_IR *registerIR);
+
 #endif // EMULATOR_REGISTER_EXECUTOR_H
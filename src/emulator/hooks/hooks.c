@@ -0,0 +1,147 @@
+///
+/// hooks.c
+/// Callbacks run on events of a run, so that it can be instrumented without changing the engines.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "hooks.h"
+
+static void addHook(Memory memory, HookKind kind, Hook hook);
+
+/// Attaches a hook called once each instruction run over [memory] has executed.
+/// @param memory The virtual memory.
+/// @param hook The hook.
+/// @param context The context to call [hook] with, and by which it is removed.
+/// @remark Hooks must not be attached or removed from within a hook. While any is attached, every engine steps one
+/// instruction at a time, see [runHooked].
+void addRetireHook(Memory memory, RetireHook hook, void *context) {
+    addHook(memory, RETIRE_HOOK, (Hook) { .function.retire = hook, .context = context });
+}
+
+/// Attaches a hook called as each instruction run over [memory] reads it.
+/// @param memory The virtual memory.
+/// @param hook The hook.
+/// @param context The context to call [hook] with, and by which it is removed.
+void addReadHook(Memory memory, MemoryHook hook, void *context) {
+    addHook(memory, READ_HOOK, (Hook) { .function.memory = hook, .context = context });
+}
+
+/// Attaches a hook called as each write to [memory] is about to land.
+/// @param memory The virtual memory.
+/// @param hook The hook.
+/// @param context The context to call [hook] with, and by which it is removed.
+/// @remark Every write through [writeMem] or [exchangeMem] is seen, not only those of instructions.
+void addWriteHook(Memory memory, MemoryHook hook, void *context) {
+    addHook(memory, WRITE_HOOK, (Hook) { .function.memory = hook, .context = context });
+}
+
+/// Attaches a hook called once each instruction run over [memory] has moved the PC anywhere but the next one.
+/// @param memory The virtual memory.
+/// @param hook The hook.
+/// @param context The context to call [hook] with, and by which it is removed.
+void addBranchHook(Memory memory, BranchHook hook, void *context) {
+    addHook(memory, BRANCH_HOOK, (Hook) { .function.branch = hook, .context = context });
+}
+
+/// Attaches a hook called whenever a run over [memory] reaches a halt.
+/// @param memory The virtual memory.
+/// @param hook The hook.
+/// @param context The context to call [hook] with, and by which it is removed.
+void addHaltHook(Memory memory, HaltHook hook, void *context) {
+    addHook(memory, HALT_HOOK, (Hook) { .function.halt = hook, .context = context });
+}
+
+/// Removes every hook attached to [memory] with [context].
+/// @param memory The virtual memory.
+/// @param context The context the hooks were attached with.
+/// @remark Once the last is removed, runs go back to full speed.
+void removeHooks(Memory memory, void *context) {
+    Hooks hooks = memory->hooks;
+    if (hooks == NULL) return;
+
+    size_t remaining = 0;
+    for (HookKind kind = 0; kind < HOOK_KINDS; kind++) {
+        size_t kept = 0;
+        for (size_t i = 0; i < hooks->counts[kind]; i++) {
+            if (hooks->hooks[kind][i].context != context) hooks->hooks[kind][kept++] = hooks->hooks[kind][i];
+        }
+
+        hooks->counts[kind] = kept;
+        remaining += kept;
+    }
+
+    if (remaining == 0) {
+        free(hooks);
+        memory->hooks = NULL;
+    }
+}
+
+/// Runs the program from the current PC until it reaches a halt, or [Registers_s.instructions] reaches [limit],
+/// calling the hooks attached to [memory] as it goes.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory, with hooks attached.
+/// @param limit The instruction count to stop at.
+/// @returns Why execution stopped, i.e., [STOP_HALTED] or [STOP_BUDGET].
+/// @remark This is what [runFor] runs, whatever the engine, while any hook is attached: instructions are stepped
+/// one at a time, as by the reference engine, so that no event is folded away. The engines themselves never check
+/// for hooks, so cost nothing more without them.
+StopReason runHooked(Registers registers, Memory memory, uint64_t limit) {
+    Instruction word;
+    while ((word = fetchMem(memory, getRegPC(registers))) != HALT) {
+        if (registers->instructions >= limit) return STOP_BUDGET;
+
+        BitData pc = getRegPC(registers);
+        executeInstruction(word, registers, memory);
+
+        Hooks hooks = memory->hooks;
+        for (size_t i = 0; i < hooks->counts[RETIRE_HOOK]; i++) {
+            Hook *hook = &hooks->hooks[RETIRE_HOOK][i];
+            hook->function.retire(hook->context, registers, memory, pc, word);
+        }
+
+        BitData next = getRegPC(registers);
+        if (next == pc + WORD_SIZE) continue;
+
+        for (size_t i = 0; i < hooks->counts[BRANCH_HOOK]; i++) {
+            Hook *hook = &hooks->hooks[BRANCH_HOOK][i];
+            hook->function.branch(hook->context, registers, pc, next);
+        }
+    }
+
+    Hooks hooks = memory->hooks;
+    for (size_t i = 0; i < hooks->counts[HALT_HOOK]; i++) {
+        Hook *hook = &hooks->hooks[HALT_HOOK][i];
+        hook->function.halt(hook->context, registers, memory);
+    }
+
+    return STOP_HALTED;
+}
+
+/// Calls the read or write hooks attached to [memory] on an access.
+/// @param memory The address of the virtual memory, with hooks attached.
+/// @param access The access.
+void fireMemoryHooks(Memory memory, const MemoryAccess *access) {
+    HookKind kind = access->write ? WRITE_HOOK : READ_HOOK;
+    Hooks hooks = memory->hooks;
+
+    for (size_t i = 0; i < hooks->counts[kind]; i++) {
+        Hook *hook = &hooks->hooks[kind][i];
+        hook->function.memory(hook->context, access);
+    }
+}
+
+/// Attaches a hook of the given kind to [memory], making its table of hooks if it has none.
+/// @param memory The virtual memory.
+/// @param kind The kind of hook.
+/// @param hook The hook.
+static void addHook(Memory memory, HookKind kind, Hook hook) {
+    if (memory->hooks == NULL) {
+        memory->hooks = calloc(1, sizeof(Hooks_s));
+        assertFatalNotNull(memory->hooks, "<Hooks> Unable to allocate [Hooks_s]!");
+    }
+
+    Hooks hooks = memory->hooks;
+    assertFatal(hooks->counts[kind] < MAX_HOOKS, "<Hooks> Too many hooks of one kind!");
+    hooks->hooks[kind][hooks->counts[kind]++] = hook;
+}
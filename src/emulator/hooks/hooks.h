@@ -0,0 +1,86 @@
+///
+/// hooks.h
+/// Callbacks run on events of a run, so that it can be instrumented without changing the engines.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_HOOKS_H
+#define EMULATOR_HOOKS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "const.h"
+#include "emulatorDelegate.h"
+#include "emulatorPlugin.h"
+#include "error.h"
+#include "memory.h"
+#include "registers.h"
+
+/// The most hooks of each kind which may be attached to one memory at once.
+#define MAX_HOOKS 16
+
+/// The events a hook can be attached to.
+typedef enum {
+    /// An instruction executed, see [RetireHook].
+    RETIRE_HOOK,
+
+    /// Memory was read, see [MemoryHook].
+    READ_HOOK,
+
+    /// Memory is about to be written, see [MemoryHook].
+    WRITE_HOOK,
+
+    /// A branch was taken, see [BranchHook].
+    BRANCH_HOOK,
+
+    /// A halt was reached, see [HaltHook].
+    HALT_HOOK,
+
+    /// The number of kinds of hook.
+    HOOK_KINDS
+} HookKind;
+
+/// A hook attached to a memory.
+typedef struct {
+    /// The function called, of the type for its kind.
+    union {
+        RetireHook retire;
+        MemoryHook memory;
+        BranchHook branch;
+        HaltHook halt;
+    } function;
+
+    /// The context it is called with.
+    void *context;
+} Hook;
+
+/// The hooks attached to a memory, by kind, each in the order they were attached.
+typedef struct Hooks_s {
+    /// The hooks of each kind.
+    Hook hooks[HOOK_KINDS][MAX_HOOKS];
+
+    /// The number of [hooks] of each kind.
+    size_t counts[HOOK_KINDS];
+} Hooks_s;
+
+void addRetireHook(Memory memory, RetireHook hook, void *context);
+
+void addReadHook(Memory memory, MemoryHook hook, void *context);
+
+void addWriteHook(Memory memory, MemoryHook hook, void *context);
+
+void addBranchHook(Memory memory, BranchHook hook, void *context);
+
+void addHaltHook(Memory memory, HaltHook hook, void *context);
+
+void removeHooks(Memory memory, void *context);
+
+StopReason runHooked(Registers registers, Memory memory, uint64_t limit);
+
+void fireMemoryHooks(Memory memory, const MemoryAccess *access);
+
+#endif // EMULATOR_HOOKS_H
@@ -0,0 +1,631 @@
+///
+/// jit.c
+/// Compiles hot basic blocks to host x86-64 machine code.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "jit.h"
+
+#if defined(__x86_64__)
+
+/// The x86-64 general purpose registers, by encoding.
+enum HostRegister {
+    RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI,
+    R8, R9, R10, R11, R12, R13, R14, R15
+};
+
+/// The x86-64 condition codes, by encoding.
+enum HostCondition {
+    CC_O = 0x0, CC_B = 0x2, CC_AE = 0x3, CC_E = 0x4, CC_NE = 0x5, CC_S = 0x8
+};
+
+/// The x86-64 group-1 arithmetic operations, by encoding.
+enum HostArithmetic {
+    ALU_ADD = 0, ALU_OR = 1, ALU_AND = 4, ALU_SUB = 5, ALU_XOR = 6
+};
+
+/// The host register holding the [Registers] pointer for the whole block.
+#define REGISTERS_BASE RBX
+
+/// The host register holding the [Memory] pointer for the whole block.
+#define MEMORY_BASE    RBP
+
+/// The host registers guest registers are cached in. All are callee-saved.
+static const uint8_t cacheRegisters[JIT_CACHED_REGS] = { R12, R13, R14, R15 };
+
+/// An operand for the r/m field of an instruction: a host register, or a displacement off a base register.
+typedef struct {
+    /// Whether this operand is a host register, rather than memory.
+    bool isRegister;
+
+    /// The host register, or the base register of the memory operand.
+    uint8_t reg;
+
+    /// The displacement of the memory operand from [reg].
+    int32_t disp;
+} Operand;
+
+/// State of the compilation of one block.
+typedef struct {
+    /// The next byte to emit to.
+    uint8_t *cursor;
+
+    /// The first byte past the end of the space reserved for this block.
+    uint8_t *limit;
+
+    /// The host register caching each guest register, or 0 (RAX, never used for caching) if uncached.
+    uint8_t cached[NO_GPRS];
+
+    /// The [Memory_s.codeVersion] the block is being compiled under.
+    uint64_t codeVersion;
+
+    /// Whether the flags are known to be evaluated into [Registers_s.pstate] at this point of the block.
+    bool flagsEvaluated;
+} JitContext;
+
+static void emitEntry(JitContext *ctx, BlockEntry *entry, BitData address);
+
+static bool emitImmediate(JitContext *ctx, Immediate_IR *ir);
+
+static bool emitRegister(JitContext *ctx, Register_IR *ir);
+
+static void emitBranch(JitContext *ctx, Branch_IR *ir, BitData address);
+
+static void emitFallback(JitContext *ctx, BlockEntry *entry, BitData address);
+
+static void emitExit(JitContext *ctx, BitData nextPC, bool completed);
+
+static void emitReturn(JitContext *ctx, bool completed);
+
+static void allocateRegisters(JitContext *ctx, Block *block);
+
+/// Emits a single byte.
+/// @param ctx The compilation state.
+/// @param byte The byte to emit.
+static void emit8(JitContext *ctx, uint8_t byte) {
+    assertFatal(ctx->cursor < ctx->limit, "<JIT> Emitted past the end of the reserved code space!");
+    *ctx->cursor++ = byte;
+}
+
+/// Emits a little-endian 32-bit value.
+/// @param ctx The compilation state.
+/// @param value The value to emit.
+static void emit32(JitContext *ctx, uint32_t value) {
+    for (int i = 0; i < 4; i++) emit8(ctx, (uint8_t) (value >> 8 * i));
+}
+
+/// Emits a little-endian 64-bit value.
+/// @param ctx The compilation state.
+/// @param value The value to emit.
+static void emit64(JitContext *ctx, uint64_t value) {
+    for (int i = 0; i < 8; i++) emit8(ctx, (uint8_t) (value >> 8 * i));
+}
+
+/// Shorthand for a host register operand.
+/// @param reg The host register.
+/// @returns The [Operand].
+static Operand hostOperand(uint8_t reg) {
+    return (Operand) { .isRegister = true, .reg = reg, .disp = 0 };
+}
+
+/// Shorthand for a memory operand displaced from the [Registers] pointer.
+/// @param disp The displacement, in bytes, into [Registers_s].
+/// @returns The [Operand].
+static Operand registersOperand(size_t disp) {
+    return (Operand) { .isRegister = false, .reg = REGISTERS_BASE, .disp = (int32_t) disp };
+}
+
+/// Emits an instruction of the form [REX] opcode ModRM [disp32].
+/// @param ctx The compilation state.
+/// @param wide Whether the operation is 64-bit (REX.W).
+/// @param opcode The opcode bytes.
+/// @param opcodeLength The number of opcode bytes.
+/// @param regField The register, or opcode extension, for the ModRM reg field.
+/// @param rm The operand for the ModRM r/m field.
+static void emitModRM(JitContext *ctx, bool wide, const uint8_t *opcode, size_t opcodeLength,
+                      uint8_t regField, Operand rm) {
+    uint8_t rex = 0x40 | (wide << 3) | ((regField >> 3) << 2) | (rm.reg >> 3);
+    if (rex != 0x40) emit8(ctx, rex);
+
+    for (size_t i = 0; i < opcodeLength; i++) emit8(ctx, opcode[i]);
+
+    if (rm.isRegister) {
+        emit8(ctx, 0xC0 | (regField & 7) << 3 | (rm.reg & 7));
+    } else {
+        // [base + disp32]; neither RBX nor RBP needs a SIB byte.
+        emit8(ctx, 0x80 | (regField & 7) << 3 | (rm.reg & 7));
+        emit32(ctx, rm.disp);
+    }
+}
+
+/// Emits \code mov reg, imm64 \endcode
+static void emitMoveImmediate(JitContext *ctx, uint8_t reg, uint64_t value) {
+    emit8(ctx, 0x48 | (reg >> 3));
+    emit8(ctx, 0xB8 | (reg & 7));
+    emit64(ctx, value);
+}
+
+/// Emits \code mov reg, rm \endcode
+static void emitLoad(JitContext *ctx, bool wide, uint8_t reg, Operand rm) {
+    emitModRM(ctx, wide, (uint8_t[]) { 0x8B }, 1, reg, rm);
+}
+
+/// Emits \code mov rm, reg \endcode
+static void emitStore(JitContext *ctx, bool wide, Operand rm, uint8_t reg) {
+    emitModRM(ctx, wide, (uint8_t[]) { 0x89 }, 1, reg, rm);
+}
+
+/// Emits \code <op> dst, src \endcode for a group-1 arithmetic operation.
+static void emitArithmetic(JitContext *ctx, bool wide, enum HostArithmetic op, uint8_t dst, uint8_t src) {
+    emitModRM(ctx, wide, (uint8_t[]) { (op << 3) | 0x1 }, 1, src, hostOperand(dst));
+}
+
+/// Emits \code <op> dst, imm32 \endcode for a group-1 arithmetic operation.
+static void emitArithmeticImmediate(JitContext *ctx, bool wide, enum HostArithmetic op, uint8_t dst, uint32_t imm) {
+    emitModRM(ctx, wide, (uint8_t[]) { 0x81 }, 1, op, hostOperand(dst));
+    emit32(ctx, imm);
+}
+
+/// Emits a shift or rotate of [reg] by the constant [amount].
+static void emitShift(JitContext *ctx, bool wide, enum ShiftType shift, uint8_t reg, uint8_t amount) {
+    if (amount == 0) return;
+
+    // Opcode extensions of C1 /n for ROL, ROR, RCL, RCR, SHL, SHR, SAL, SAR.
+    static const uint8_t extensions[] = { [LSL] = 4, [LSR] = 5, [ASR] = 7, [ROR] = 1 };
+    emitModRM(ctx, wide, (uint8_t[]) { 0xC1 }, 1, extensions[shift], hostOperand(reg));
+    emit8(ctx, amount);
+}
+
+/// Emits \code set<cc> byte [Registers + disp] \endcode
+static void emitSetFlag(JitContext *ctx, enum HostCondition condition, size_t disp) {
+    emitModRM(ctx, false, (uint8_t[]) { 0x0F, 0x90 | condition }, 2, 0, registersOperand(disp));
+}
+
+/// Emits \code mov byte [Registers + disp], value \endcode
+static void emitClearFlag(JitContext *ctx, size_t disp) {
+    emitModRM(ctx, false, (uint8_t[]) { 0xC6 }, 1, 0, registersOperand(disp));
+    emit8(ctx, 0);
+}
+
+/// Emits a jump with a 32-bit displacement, to be patched by [patchJump].
+/// @param condition The condition to jump on, or -1 for an unconditional jump.
+/// @returns The address of the displacement to patch.
+static uint8_t *emitJump(JitContext *ctx, int condition) {
+    if (condition < 0) {
+        emit8(ctx, 0xE9);
+    } else {
+        emit8(ctx, 0x0F);
+        emit8(ctx, 0x80 | condition);
+    }
+    uint8_t *displacement = ctx->cursor;
+    emit32(ctx, 0);
+    return displacement;
+}
+
+/// Points the jump whose displacement is at [displacement] to the next byte to be emitted.
+static void patchJump(JitContext *ctx, uint8_t *displacement) {
+    int32_t relative = (int32_t) (ctx->cursor - (displacement + 4));
+    for (int i = 0; i < 4; i++) displacement[i] = (uint8_t) ((uint32_t) relative >> 8 * i);
+}
+
+/// Gets the displacement of X[id] within [Registers_s].
+static size_t gprOffset(uint8_t id) {
+    return offsetof(Registers_s, gprs) + id * sizeof(BitData);
+}
+
+/// Gets the displacement of a [PState] flag within [Registers_s].
+#define flagOffset(__FIELD__) (offsetof(Registers_s, pstate) + offsetof(PState, __FIELD__))
+
+/// Emits a load of guest register X[id] into host register [reg].
+static void loadGuest(JitContext *ctx, uint8_t reg, uint8_t id) {
+    if (id == ZERO_REGISTER) {
+        // xor reg32, reg32
+        emitArithmetic(ctx, false, ALU_XOR, reg, reg);
+    } else if (ctx->cached[id]) {
+        emitLoad(ctx, true, reg, hostOperand(ctx->cached[id]));
+    } else {
+        emitLoad(ctx, true, reg, registersOperand(gprOffset(id)));
+    }
+}
+
+/// Emits a store of host register [reg] to guest register X[id].
+/// @remark 32-bit results are stored whole, since 32-bit host operations already zero the upper half.
+static void storeGuest(JitContext *ctx, uint8_t id, uint8_t reg) {
+    if (id == ZERO_REGISTER) return;
+
+    if (ctx->cached[id]) {
+        emitStore(ctx, true, hostOperand(ctx->cached[id]), reg);
+    } else {
+        emitStore(ctx, true, registersOperand(gprOffset(id)), reg);
+    }
+}
+
+/// Emits a write-back of every cached guest register to [Registers_s].
+static void spillCached(JitContext *ctx) {
+    for (uint8_t id = 0; id < NO_GPRS; id++) {
+        if (ctx->cached[id]) emitStore(ctx, true, registersOperand(gprOffset(id)), ctx->cached[id]);
+    }
+}
+
+/// Emits a reload of every cached guest register from [Registers_s].
+static void fillCached(JitContext *ctx) {
+    for (uint8_t id = 0; id < NO_GPRS; id++) {
+        if (ctx->cached[id]) emitLoad(ctx, true, ctx->cached[id], registersOperand(gprOffset(id)));
+    }
+}
+
+/// Emits the marking of the flags as evaluated, once native code has written all of [Registers_s.pstate].
+/// @remark The host flags make evaluating NZCV as cheap as recording the operation, so native code never defers it.
+static void emitFlagsEvaluated(JitContext *ctx) {
+    // mov dword [Registers + flags.source], FLAGS_EVALUATED
+    emitModRM(ctx, false, (uint8_t[]) { 0xC7 }, 1, 0,
+              registersOperand(offsetof(Registers_s, flags) + offsetof(LazyFlags, source)));
+    emit32(ctx, FLAGS_EVALUATED);
+    ctx->flagsEvaluated = true;
+}
+
+/// Emits the NZCV updates following an x86 ADD or SUB which set the host flags.
+/// @param subtract Whether the operation was a subtraction, where the AArch64 carry is the inverted host borrow.
+static void emitArithmeticFlags(JitContext *ctx, bool subtract) {
+    emitSetFlag(ctx, CC_S, flagOffset(ng));
+    emitSetFlag(ctx, CC_E, flagOffset(zr));
+    emitSetFlag(ctx, subtract ? CC_AE : CC_B, flagOffset(cr));
+    emitSetFlag(ctx, CC_O, flagOffset(ov));
+    emitFlagsEvaluated(ctx);
+}
+
+/// Compiles [block] to host machine code, setting its [Block.native] on success.
+/// @param cache The cache that [block] belongs to, which owns the executable code region.
+/// @param block The block to compile.
+/// @param memory The virtual memory [block] was decoded from.
+/// @returns Whether [block] was compiled.
+/// @remark Instructions without a native translation are compiled to calls of their executor, so every block
+/// whose code fits in the region can be compiled.
+bool compileBlock(BlockCache cache, Block *block, Memory memory) {
+    if (cache->code == NULL) {
+        cache->code = mmap(NULL, NATIVE_REGION_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC,
+                           MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+
+        // The host may forbid writable, executable mappings; interpret instead.
+        if (cache->code == MAP_FAILED) {
+            cache->code = NULL;
+            return false;
+        }
+        cache->codeUsed = 0;
+    }
+
+    // Prologue, epilogue, and exits are comfortably under one entry's worth of code each.
+    size_t reserve = (block->length + 4) * JIT_MAX_ENTRY_BYTES;
+    if (cache->codeUsed + reserve > NATIVE_REGION_SIZE) return false;
+
+    JitContext ctx = {
+        .cursor = cache->code + cache->codeUsed,
+        .limit = cache->code + cache->codeUsed + reserve,
+        .codeVersion = memory->codeVersion,
+    };
+    uint8_t *start = ctx.cursor;
+    allocateRegisters(&ctx, block);
+
+    // Prologue: save callee-saved registers, keeping the stack 16-byte aligned for calls.
+    static const uint8_t saved[] = { RBX, RBP, R12, R13, R14, R15 };
+    for (size_t i = 0; i < sizeof(saved); i++) {
+        if (saved[i] >> 3) emit8(&ctx, 0x41);
+        emit8(&ctx, 0x50 | (saved[i] & 7));
+    }
+    emit32(&ctx, 0x08EC8348); // sub rsp, 8
+
+    // mov rbx, rdi; mov rbp, rsi
+    emitLoad(&ctx, true, REGISTERS_BASE, hostOperand(RDI));
+    emitLoad(&ctx, true, MEMORY_BASE, hostOperand(RSI));
+    fillCached(&ctx);
+
+    for (size_t i = 0; i < block->length; i++) {
+        emitEntry(&ctx, &block->entries[i], block->start + i * WORD_SIZE);
+    }
+
+    // Blocks which end without a branch fall through to their end.
+    if (!block->branches) emitExit(&ctx, block->end, true);
+
+    cache->codeUsed += ctx.cursor - start;
+
+    // ISO C has no object-to-function pointer conversion, but POSIX guarantees their representations agree.
+    memcpy(&block->native, &start, sizeof(block->native));
+    return true;
+}
+
+/// Emits the code for a single instruction of a block.
+/// @param ctx The compilation state.
+/// @param entry The instruction.
+/// @param address The guest address of the instruction.
+static void emitEntry(JitContext *ctx, BlockEntry *entry, BitData address) {
+    switch (entry->ir.type) {
+        case IMMEDIATE:
+            if (!emitImmediate(ctx, &entry->ir.ir.immediateIR)) emitFallback(ctx, entry, address);
+            break;
+
+        case REGISTER:
+            if (!emitRegister(ctx, &entry->ir.ir.registerIR)) emitFallback(ctx, entry, address);
+            break;
+
+        case BRANCH:
+            emitBranch(ctx, &entry->ir.ir.branchIR, address);
+            break;
+
+        default:
+            emitFallback(ctx, entry, address);
+            break;
+    }
+}
+
+/// Emits native code for a data processing (immediate) instruction.
+/// @returns Whether the instruction has a native translation.
+static bool emitImmediate(JitContext *ctx, Immediate_IR *ir) {
+    if (ir->opi == IMMEDIATE_ARITHMETIC) {
+        struct Arithmetic *operand = &ir->operand.arithmetic;
+        uint32_t op2 = operand->imm12 << (operand->sh * 12);
+        bool subtract = ir->opc.arithmeticType == SUB || ir->opc.arithmeticType == SUBS;
+        bool setFlags = ir->opc.arithmeticType == ADDS || ir->opc.arithmeticType == SUBS;
+
+        loadGuest(ctx, RAX, operand->rn);
+        emitArithmeticImmediate(ctx, ir->sf, subtract ? ALU_SUB : ALU_ADD, RAX, op2);
+        if (setFlags) emitArithmeticFlags(ctx, subtract);
+        storeGuest(ctx, ir->rd, RAX);
+        return true;
+    }
+
+    struct WideMove *operand = &ir->operand.wideMove;
+    uint64_t op = (uint64_t) operand->imm16 << (operand->hw * 16);
+
+    switch (ir->opc.wideMoveType) {
+        case MOVN:
+            emitMoveImmediate(ctx, RAX, ir->sf ? ~op : (uint32_t) ~op);
+            break;
+
+        case MOVZ:
+            emitMoveImmediate(ctx, RAX, op);
+            break;
+
+        case MOVK:
+            loadGuest(ctx, RAX, ir->rd);
+            emitMoveImmediate(ctx, RCX, ~((uint64_t) UINT16_MAX << (operand->hw * 16)));
+            emitArithmetic(ctx, true, ALU_AND, RAX, RCX);
+            emitMoveImmediate(ctx, RCX, op);
+            emitArithmetic(ctx, true, ALU_OR, RAX, RCX);
+
+            // mov eax, eax truncates to 32 bits.
+            if (!ir->sf) emitLoad(ctx, false, RAX, hostOperand(RAX));
+            break;
+
+        default:
+            return false;
+    }
+
+    storeGuest(ctx, ir->rd, RAX);
+    return true;
+}
+
+/// Emits native code for a data processing (register) instruction.
+/// @returns Whether the instruction has a native translation.
+static bool emitRegister(JitContext *ctx, Register_IR *ir) {
+    if (ir->group == MULTIPLY) {
+        loadGuest(ctx, RAX, ir->rn);
+        loadGuest(ctx, RCX, ir->rm);
+        loadGuest(ctx, RDX, ir->operand.multiply.ra);
+
+        // imul rax, rcx
+        emitModRM(ctx, ir->sf, (uint8_t[]) { 0x0F, 0xAF }, 2, RAX, hostOperand(RCX));
+        if (ir->operand.multiply.x) {
+            emitArithmetic(ctx, ir->sf, ALU_SUB, RDX, RAX);
+            storeGuest(ctx, ir->rd, RDX);
+        } else {
+            emitArithmetic(ctx, ir->sf, ALU_ADD, RAX, RDX);
+            storeGuest(ctx, ir->rd, RAX);
+        }
+        return true;
+    }
+
+    // 32-bit shifts of 32 or more are not encodable; leave them to the interpreter.
+    if (!ir->sf && ir->operand.imm6 >= 32) return false;
+
+    loadGuest(ctx, RCX, ir->rm);
+    emitShift(ctx, ir->sf, ir->shift, RCX, ir->operand.imm6);
+    loadGuest(ctx, RAX, ir->rn);
+
+    if (ir->group == ARITHMETIC) {
+        bool subtract = ir->opc.arithmetic == SUB || ir->opc.arithmetic == SUBS;
+        bool setFlags = ir->opc.arithmetic == ADDS || ir->opc.arithmetic == SUBS;
+
+        emitArithmetic(ctx, ir->sf, subtract ? ALU_SUB : ALU_ADD, RAX, RCX);
+        if (setFlags) emitArithmeticFlags(ctx, subtract);
+        storeGuest(ctx, ir->rd, RAX);
+        return true;
+    }
+
+    // Bit-logic, whose opcodes share ordinals between the standard and negated forms.
+    if (ir->negated) {
+        // not rcx
+        emitModRM(ctx, ir->sf, (uint8_t[]) { 0xF7 }, 1, 2, hostOperand(RCX));
+    }
+
+    static const enum HostArithmetic logic[] = { [AND] = ALU_AND, [ORR] = ALU_OR, [EOR] = ALU_XOR, [ANDS] = ALU_AND };
+    emitArithmetic(ctx, ir->sf, logic[ir->opc.logic.standard], RAX, RCX);
+
+    if (ir->opc.logic.standard == ANDS) {
+        // Logical operations clear C and V; the host AND has set SF and ZF from the result.
+        emitSetFlag(ctx, CC_S, flagOffset(ng));
+        emitSetFlag(ctx, CC_E, flagOffset(zr));
+        emitClearFlag(ctx, flagOffset(cr));
+        emitClearFlag(ctx, flagOffset(ov));
+        emitFlagsEvaluated(ctx);
+    }
+
+    storeGuest(ctx, ir->rd, RAX);
+    return true;
+}
+
+/// Gets the address a branch at [address] continues from, were it to jump to [target].
+/// @remark As in [execute], a branch which leaves the PC where it was is treated as not having branched.
+static BitData branchTarget(BitData address, BitData target) {
+    return target == address ? address + WORD_SIZE : target;
+}
+
+/// Emits native code for a branch instruction, which always terminates its block.
+/// @param address The guest address of the branch.
+static void emitBranch(JitContext *ctx, Branch_IR *ir, BitData address) {
+    switch (ir->type) {
+        case BRANCH_UNCONDITIONAL: {
+            int64_t offset = ir->data.simm26.data.immediate;
+            emitExit(ctx, branchTarget(address, address + 4 * offset), true);
+            break;
+        }
+
+        case BRANCH_REGISTER: {
+            loadGuest(ctx, RAX, ir->data.xn);
+
+            // Step over the branch if it targets itself.
+            emitMoveImmediate(ctx, RCX, address);
+            emitModRM(ctx, true, (uint8_t[]) { 0x39 }, 1, RCX, hostOperand(RAX)); // cmp rax, rcx
+            uint8_t *elsewhere = emitJump(ctx, CC_NE);
+            emitArithmeticImmediate(ctx, true, ALU_ADD, RAX, WORD_SIZE);
+            patchJump(ctx, elsewhere);
+
+            emitStore(ctx, true, registersOperand(offsetof(Registers_s, pc)), RAX);
+            emitReturn(ctx, true);
+            break;
+        }
+
+        case BRANCH_CONDITIONAL: {
+            int64_t offset = ir->data.conditional.simm19.data.immediate;
+
+            // Flags left pending by the interpreter, before or within this block, are evaluated first.
+            if (!ctx->flagsEvaluated) {
+                emitLoad(ctx, true, RDI, hostOperand(REGISTERS_BASE));
+                emitMoveImmediate(ctx, RAX, (uint64_t) evaluateRegStates);
+                emit8(ctx, 0xFF); // call rax
+                emit8(ctx, 0xD0);
+            }
+
+            // Pack NZCV into eax, then test its bit in the condition's truth table.
+            emitModRM(ctx, false, (uint8_t[]) { 0x0F, 0xB6 }, 2, RAX, registersOperand(flagOffset(ng)));
+            size_t flags[] = { flagOffset(zr), flagOffset(cr), flagOffset(ov) };
+            for (size_t i = 0; i < 3; i++) {
+                emitShift(ctx, false, LSL, RAX, 1);
+                emitModRM(ctx, false, (uint8_t[]) { 0x0F, 0xB6 }, 2, RCX, registersOperand(flags[i]));
+                emitArithmetic(ctx, false, ALU_OR, RAX, RCX);
+            }
+            emit8(ctx, 0xB8 | RDX);
+            emit32(ctx, conditionTruthTable(ir->data.conditional.condition));
+
+            // bt edx, eax
+            emitModRM(ctx, false, (uint8_t[]) { 0x0F, 0xA3 }, 2, RAX, hostOperand(RDX));
+            uint8_t *taken = emitJump(ctx, CC_B);
+
+            emitExit(ctx, address + WORD_SIZE, true);
+            patchJump(ctx, taken);
+            emitExit(ctx, branchTarget(address, address + 4 * offset), true);
+            break;
+        }
+    }
+}
+
+/// Emits a call to the interpreter's executor for an instruction without a native translation.
+/// @param entry The instruction.
+/// @param address The guest address of the instruction.
+static void emitFallback(JitContext *ctx, BlockEntry *entry, BitData address) {
+    // The executor sees the registers as they would be mid-interpretation, PC included.
+    spillCached(ctx);
+    emitMoveImmediate(ctx, RAX, address);
+    emitStore(ctx, true, registersOperand(offsetof(Registers_s, pc)), RAX);
+
+    emitMoveImmediate(ctx, RDI, (uint64_t) &entry->ir);
+    emitLoad(ctx, true, RSI, hostOperand(REGISTERS_BASE));
+    emitLoad(ctx, true, RDX, hostOperand(MEMORY_BASE));
+    emitMoveImmediate(ctx, RAX, (uint64_t) entry->execute);
+    emit8(ctx, 0xFF); // call rax
+    emit8(ctx, 0xD0);
+
+    fillCached(ctx);
+    ctx->flagsEvaluated = false;
+
+    // A store may have overwritten decoded code, possibly this very block, or a barrier discarded it.
+    if (entry->ir.type == LOAD_STORE || entry->ir.type == BARRIER) {
+        emitLoad(ctx, true, RAX, (Operand) { false, MEMORY_BASE, offsetof(Memory_s, codeVersion) });
+        emitMoveImmediate(ctx, RCX, ctx->codeVersion);
+        emitModRM(ctx, true, (uint8_t[]) { 0x39 }, 1, RCX, hostOperand(RAX)); // cmp rax, rcx
+        uint8_t *unchanged = emitJump(ctx, CC_E);
+        emitExit(ctx, address + WORD_SIZE, false);
+        patchJump(ctx, unchanged);
+    }
+}
+
+/// Emits a return from the compiled block, continuing execution from [nextPC].
+/// @param nextPC The guest address execution continues from.
+/// @param completed Whether the whole block was executed.
+static void emitExit(JitContext *ctx, BitData nextPC, bool completed) {
+    emitMoveImmediate(ctx, RAX, nextPC);
+    emitStore(ctx, true, registersOperand(offsetof(Registers_s, pc)), RAX);
+    emitReturn(ctx, completed);
+}
+
+/// Emits a return from the compiled block, once the PC has been set.
+/// @param completed Whether the whole block was executed.
+static void emitReturn(JitContext *ctx, bool completed) {
+    spillCached(ctx);
+
+    emit8(ctx, 0xB8 | RAX); // mov eax, completed
+    emit32(ctx, completed);
+
+    emit32(ctx, 0x08C48348); // add rsp, 8
+    static const uint8_t restored[] = { R15, R14, R13, R12, RBP, RBX };
+    for (size_t i = 0; i < sizeof(restored); i++) {
+        if (restored[i] >> 3) emit8(ctx, 0x41);
+        emit8(ctx, 0x58 | (restored[i] & 7));
+    }
+    emit8(ctx, 0xC3); // ret
+}
+
+/// Chooses which guest registers to keep in host registers: those referenced most within the block.
+/// @param ctx The compilation state, whose [JitContext.cached] is filled in.
+/// @param block The block being compiled.
+static void allocateRegisters(JitContext *ctx, Block *block) {
+    size_t uses[NO_GPRS + 1] = { 0 };
+
+    for (size_t i = 0; i < block->length; i++) {
+        IR *ir = &block->entries[i].ir;
+        switch (ir->type) {
+            case IMMEDIATE:
+                uses[ir->ir.immediateIR.rd]++;
+                if (ir->ir.immediateIR.opi == IMMEDIATE_ARITHMETIC) uses[ir->ir.immediateIR.operand.arithmetic.rn]++;
+                break;
+
+            case REGISTER:
+                uses[ir->ir.registerIR.rd]++;
+                uses[ir->ir.registerIR.rn]++;
+                uses[ir->ir.registerIR.rm]++;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    for (size_t slot = 0; slot < JIT_CACHED_REGS; slot++) {
+        size_t best = ZERO_REGISTER;
+        for (size_t id = 0; id < NO_GPRS; id++) {
+            if (!ctx->cached[id] && uses[id] > uses[best]) best = id;
+        }
+        if (best == ZERO_REGISTER || uses[best] < 2) break;
+        ctx->cached[best] = cacheRegisters[slot];
+    }
+}
+
+#else
+
+/// Compiles [block] to host machine code - unsupported on this host, so always declines.
+/// @returns false.
+bool compileBlock(unused BlockCache cache, unused Block *block, unused Memory memory) {
+    return false;
+}
+
+#endif
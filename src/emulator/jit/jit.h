@@ -0,0 +1,34 @@
+///
+/// jit.h
+/// Compiles hot basic blocks to host x86-64 machine code.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_JIT_H
+#define EMULATOR_JIT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+#include "blockCache.h"
+#include "const.h"
+#include "error.h"
+#include "ir.h"
+#include "memory.h"
+#include "registers.h"
+
+/// The number of times a [Block] is interpreted before it is compiled.
+#define JIT_THRESHOLD       16
+
+/// The number of guest registers kept in host registers across a compiled block.
+#define JIT_CACHED_REGS     4
+
+/// The worst-case number of bytes of host code emitted for a single [BlockEntry].
+#define JIT_MAX_ENTRY_BYTES 192
+
+bool compileBlock(BlockCache cache, Block *block, Memory memory);
+
+#endif // EMULATOR_JIT_H
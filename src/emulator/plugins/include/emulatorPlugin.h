@@ -0,0 +1,175 @@
+///
+/// emulatorPlugin.h
+/// The interface between the emulator and the plugins it loads; the only header a plugin includes.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_PLUGIN_API_H
+#define EMULATOR_PLUGIN_API_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// The version of the plugin interface this build provides.
+/// @remark Bumped whenever [PluginAPI], a hook, or [MemoryAccess] changes. A plugin is only loaded by an emulator of
+/// the version it was built against, see [PluginABI].
+#define PLUGIN_API_VERSION  1
+
+/// The name of the [PluginABI] every plugin must export, as [PLUGIN_ABI].
+#define PLUGIN_ABI_SYMBOL    "emulatorPluginABI"
+
+/// The name of the [PluginInit] every plugin must export.
+#define PLUGIN_INIT_SYMBOL   "emulatorPluginInit"
+
+/// The name of the [PluginFinish] a plugin may export.
+#define PLUGIN_FINISH_SYMBOL "emulatorPluginFinish"
+
+/// The [PluginABI] of whatever is built with this header; every plugin must export it, as
+/// \code const PluginABI emulatorPluginABI = PLUGIN_ABI; \endcode
+#define PLUGIN_ABI { PLUGIN_API_VERSION, sizeof(PluginAPI), sizeof(MemoryAccess) }
+
+/// A value of a register, or of memory, of the run.
+typedef uint64_t BitData;
+
+/// An instruction of the run.
+typedef uint32_t Instruction;
+
+/// The memory of a run; opaque to plugins, which only pass it back to the emulator.
+typedef struct Memory_s *Memory;
+
+/// The registers of a run; opaque to plugins, which only read them through [PluginAPI].
+typedef struct Registers_s Registers_s;
+
+/// Why a run stopped executing.
+typedef enum {
+    /// The program reached a halt.
+    STOP_HALTED,
+
+    /// The budget of instructions ran out first.
+    STOP_BUDGET,
+
+    /// A fatal error was raised.
+    STOP_FAULT
+} StopReason;
+
+/// A load or store made by an instruction, as seen by a [MemoryHook].
+typedef struct {
+    /// Whether the access is a write, rather than a read.
+    bool write;
+
+    /// Whether the access is of 64, rather than 32, bits.
+    bool as64;
+
+    /// Whether the access is of a device's registers, see [bus.h].
+    bool device;
+
+    /// The address accessed.
+    BitData address;
+
+    /// The value read or written.
+    BitData value;
+
+    /// For a write, other than to a device, the value it overwrites; otherwise 0.
+    BitData old;
+} MemoryAccess;
+
+/// Called once an instruction has executed.
+/// @param context The context the hook was attached with.
+/// @param registers The virtual registers, as the instruction left them; only to be read.
+/// @param memory The virtual memory.
+/// @param pc The address of the instruction.
+/// @param word The instruction.
+typedef void (*RetireHook)(void *context, const Registers_s *registers, Memory memory, BitData pc, Instruction word);
+
+/// Called as an instruction reads, or is about to write, memory. Instruction fetches are not seen.
+/// @param context The context the hook was attached with.
+/// @param access The access.
+typedef void (*MemoryHook)(void *context, const MemoryAccess *access);
+
+/// Called once an instruction has moved the PC anywhere but the next instruction, after the [RetireHook]s.
+/// @param context The context the hook was attached with.
+/// @param registers The virtual registers, as the instruction left them; only to be read.
+/// @param from The address of the instruction.
+/// @param to The address it moved the PC to.
+typedef void (*BranchHook)(void *context, const Registers_s *registers, BitData from, BitData to);
+
+/// Called when a run reaches a halt, which is not executed.
+/// @param context The context the hook was attached with.
+/// @param registers The virtual registers; only to be read.
+/// @param memory The virtual memory.
+typedef void (*HaltHook)(void *context, const Registers_s *registers, Memory memory);
+
+/// What a plugin is given of the run it instruments.
+/// @remark Registers are opaque to a plugin, which is handed them by hooks only to read through the accessors here;
+/// their layout may change without [PLUGIN_API_VERSION] changing.
+typedef struct {
+    /// The [PLUGIN_API_VERSION] of the emulator.
+    uint32_t version;
+
+    /// The memory of the run, to attach hooks to and peek at.
+    Memory memory;
+
+    /// Reads memory without side effects, see [peekMem].
+    BitData (*peekMem)(Memory memory, bool as64, size_t addr);
+
+    /// Gets a general purpose register, see [getReg].
+    BitData (*getReg)(const Registers_s *registers, size_t id);
+
+    /// Gets the stack pointer, see [getRegSP].
+    BitData (*getSP)(const Registers_s *registers);
+
+    /// Gets the program counter, see [getRegPC].
+    BitData (*getPC)(const Registers_s *registers);
+
+    /// Gets NZCV, see [getRegNZCV].
+    uint8_t (*getNZCV)(const Registers_s *registers);
+
+    /// Gets the number of instructions executed so far, see [Registers_s.instructions].
+    uint64_t (*getInstructions)(const Registers_s *registers);
+
+    /// Attaches a retire hook, see [addRetireHook].
+    void (*addRetireHook)(Memory memory, RetireHook hook, void *context);
+
+    /// Attaches a read hook, see [addReadHook].
+    void (*addReadHook)(Memory memory, MemoryHook hook, void *context);
+
+    /// Attaches a write hook, see [addWriteHook].
+    void (*addWriteHook)(Memory memory, MemoryHook hook, void *context);
+
+    /// Attaches a branch hook, see [addBranchHook].
+    void (*addBranchHook)(Memory memory, BranchHook hook, void *context);
+
+    /// Attaches a halt hook, see [addHaltHook].
+    void (*addHaltHook)(Memory memory, HaltHook hook, void *context);
+
+    /// Removes the hooks attached with a context, see [removeHooks].
+    void (*removeHooks)(Memory memory, void *context);
+} PluginAPI;
+
+/// What a plugin was built against, which must match the emulator for it to be loaded.
+/// @remark The sizes catch a plugin built against a changed header whose version was not bumped.
+typedef struct {
+    /// The [PLUGIN_API_VERSION].
+    uint32_t version;
+
+    /// The size of [PluginAPI].
+    size_t apiSize;
+
+    /// The size of [MemoryAccess], which hooks are handed as is.
+    size_t accessSize;
+} PluginABI;
+
+/// Starts a plugin, which attaches whatever hooks it needs.
+/// @param api What the plugin is given of the run, valid until it is finished.
+/// @param context Set to whatever the plugin wants passed to its [PluginFinish].
+/// @returns Whether the plugin started.
+typedef bool (*PluginInit)(const PluginAPI *api, void **context);
+
+/// Finishes a plugin once the run is over, so that it can report on it. It must remove any hooks it attached.
+/// @param context The context set by its [PluginInit].
+/// @param reason Why the run stopped.
+typedef void (*PluginFinish)(void *context, StopReason reason);
+
+#endif // EMULATOR_PLUGIN_API_H
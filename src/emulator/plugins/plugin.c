@@ -0,0 +1,75 @@
+///
+/// plugin.c
+/// Loads analyses built as shared libraries, which instrument a run through its hooks.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "plugin.h"
+
+static uint64_t getInstructions(const Registers_s *registers);
+
+/// Loads a plugin, and starts it on a run.
+/// @param path The path of the plugin's shared library.
+/// @param memory The memory of the run, which only one core's registers may be run over.
+/// @returns The plugin, to be finished by [unloadPlugin] once the run is over.
+Plugin loadPlugin(const char *path, Memory memory) {
+    void *handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    assertFatalNotNullWithArgs(handle, "Unable to load plugin '%s': %s", path, dlerror());
+
+    Plugin plugin = calloc(1, sizeof(Plugin_s));
+    assertFatalNotNull(plugin, "<Plugin> Unable to allocate [Plugin_s]!");
+    plugin->handle = handle;
+
+    const PluginABI *abi = dlsym(handle, PLUGIN_ABI_SYMBOL);
+    assertFatalNotNullWithArgs(abi, "Plugin '%s' does not export %s!", path, PLUGIN_ABI_SYMBOL);
+
+    PluginABI expected = PLUGIN_ABI;
+    assertFatalWithArgs(abi->version == expected.version, "Plugin '%s' was built for version %" PRIu32
+                        " of the plugin interface, not %" PRIu32 "!", path, abi->version, expected.version);
+    assertFatalWithArgs(abi->apiSize == expected.apiSize && abi->accessSize == expected.accessSize,
+                        "Plugin '%s' was built against different plugin headers!", path);
+
+    // POSIX guarantees the symbols of functions can be converted, though ISO C does not.
+    PluginInit init;
+    *(void **) &init = dlsym(handle, PLUGIN_INIT_SYMBOL);
+    assertFatalNotNullWithArgs(init, "Plugin '%s' does not export %s!", path, PLUGIN_INIT_SYMBOL);
+    *(void **) &plugin->finish = dlsym(handle, PLUGIN_FINISH_SYMBOL);
+
+    plugin->api = (PluginAPI) {
+        .version = PLUGIN_API_VERSION,
+        .memory = memory,
+        .peekMem = peekMem,
+        .getReg = getReg,
+        .getSP = getRegSP,
+        .getPC = getRegPC,
+        .getNZCV = getRegNZCV,
+        .getInstructions = getInstructions,
+        .addRetireHook = addRetireHook,
+        .addReadHook = addReadHook,
+        .addWriteHook = addWriteHook,
+        .addBranchHook = addBranchHook,
+        .addHaltHook = addHaltHook,
+        .removeHooks = removeHooks
+    };
+
+    assertFatalWithArgs(init(&plugin->api, &plugin->context), "Plugin '%s' failed to start!", path);
+    return plugin;
+}
+
+/// Finishes a plugin, then unloads it.
+/// @param plugin The plugin.
+/// @param reason Why the run stopped.
+void unloadPlugin(Plugin plugin, StopReason reason) {
+    if (plugin->finish != NULL) plugin->finish(plugin->context, reason);
+
+    dlclose(plugin->handle);
+    free(plugin);
+}
+
+/// Gets the number of instructions executed so far.
+/// @param registers The registers.
+/// @returns [Registers_s.instructions].
+static uint64_t getInstructions(const Registers_s *registers) {
+    return registers->instructions;
+}
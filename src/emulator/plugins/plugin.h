@@ -0,0 +1,48 @@
+///
+/// plugin.h
+/// Loads analyses built as shared libraries, which instrument a run through its hooks.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_PLUGIN_H
+#define EMULATOR_PLUGIN_H
+
+#include <dlfcn.h>
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include "const.h"
+#include "emulatorDelegate.h"
+#include "emulatorPlugin.h"
+#include "error.h"
+#include "hooks.h"
+#include "memory.h"
+#include "registers.h"
+
+/// The most plugins which may be loaded at once.
+#define MAX_PLUGINS 8
+
+/// A loaded plugin.
+typedef struct {
+    /// The handle of its shared library.
+    void *handle;
+
+    /// Its finishing function, or NULL if it exports none.
+    PluginFinish finish;
+
+    /// The context it was started with.
+    void *context;
+
+    /// What it was given of the run.
+    PluginAPI api;
+} Plugin_s;
+
+/// Type definition of a pointer to [Plugin_s].
+typedef Plugin_s *Plugin;
+
+Plugin loadPlugin(const char *path, Memory memory);
+
+void unloadPlugin(Plugin plugin, StopReason reason);
+
+#endif // EMULATOR_PLUGIN_H
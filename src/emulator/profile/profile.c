@@ -0,0 +1,323 @@
+///
+/// profile.c
+/// Counts how often each instruction and basic block of a run executes, and roughly where its time goes.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "profile.h"
+
+static void profileRetire(void *context, const Registers_s *registers, Memory memory, BitData pc, Instruction word);
+
+static void sampleClock(Profile profile);
+
+static ProfileSlot *findSlot(Profile profile, BitData pc);
+
+static ProfileSlot **sortSlots(Profile profile, int (*compare)(const void *, const void *), size_t *count);
+
+static void describe(Symbols symbols, BitData pc, char *buffer, size_t size);
+
+static double percentOf(uint64_t part, uint64_t whole);
+
+static int byCount(const void *a, const void *b);
+
+static int byBlockInstructions(const void *a, const void *b);
+
+static int byAddress(const void *a, const void *b);
+
+/// The label instructions are put down to if they come before every label.
+#define UNLABELLED        "[unlabelled]"
+
+/// The number of characters [describe] writes at most, including its terminator.
+#define LOCATION_SIZE     (MAX_SYMBOL_LENGTH * 2 + 64)
+
+/// The headings of the address and location columns of a report.
+#define COLUMNS_WITH_LOCATION "address             location"
+
+/// The number of nanoseconds in a millisecond.
+#define NS_PER_MS         1e6
+
+/// Starts profiling every instruction run over [memory].
+/// @param memory The virtual memory.
+/// @returns The profile, to be stopped by [stopProfile], then freed by [freeProfile].
+/// @remark An instruction which faults is not counted.
+Profile startProfile(Memory memory) {
+    Profile profile = calloc(1, sizeof(Profile_s));
+    assertFatalNotNull(profile, "<Profile> Unable to allocate [Profile_s]!");
+
+    profile->slots = calloc(PROFILE_INITIAL_SLOTS, sizeof(ProfileSlot));
+    assertFatalNotNull(profile->slots, "<Profile> Unable to allocate slots!");
+    profile->capacity = PROFILE_INITIAL_SLOTS;
+    profile->blockEnded = true;
+    profile->memory = memory;
+
+    clock_gettime(CLOCK_MONOTONIC, &profile->lastSample);
+    addRetireHook(memory, profileRetire, profile);
+    return profile;
+}
+
+/// Stops profiling, putting the time since the clock was last sampled down to the basic block last executing.
+/// @param profile The profile.
+void stopProfile(Profile profile) {
+    removeHooks(profile->memory, profile);
+    sampleClock(profile);
+}
+
+/// Writes a report of the profile, hottest first: of its instructions, its basic blocks, and, given symbols, its
+/// labels.
+/// @param profile The profile.
+/// @param symbols The symbols of the program run, or NULL if there are none.
+/// @param out The file to write to.
+void writeProfile(Profile profile, Symbols symbols, FILE *out) {
+    char location[LOCATION_SIZE];
+    size_t count;
+
+    fprintf(out, "Profile of %" PRIu64 " instructions, over %.3f ms.\n", profile->instructions,
+            profile->nanoseconds / NS_PER_MS);
+
+    fprintf(out, "\nInstructions, by executions:\n");
+    fprintf(out, "%14s %8s  %s\n", "executions", "%", symbols != NULL ? COLUMNS_WITH_LOCATION : "address");
+    ProfileSlot **slots = sortSlots(profile, byCount, &count);
+    for (size_t i = 0; i < count; i++) {
+        describe(symbols, slots[i]->pc, location, sizeof(location));
+        fprintf(out, "%14" PRIu64 " %7.2f%%  0x%016" PRIx64 "%s\n", slots[i]->count,
+                percentOf(slots[i]->count, profile->instructions), slots[i]->pc, location);
+    }
+    free(slots);
+
+    fprintf(out, "\nBasic blocks, by instructions executed:\n");
+    fprintf(out, "%14s %14s %8s %12s  %s\n", "entries", "instructions", "%", "time (ms)",
+            symbols != NULL ? COLUMNS_WITH_LOCATION : "address");
+    slots = sortSlots(profile, byBlockInstructions, &count);
+    for (size_t i = 0; i < count && slots[i]->entries > 0; i++) {
+        describe(symbols, slots[i]->pc, location, sizeof(location));
+        fprintf(out, "%14" PRIu64 " %14" PRIu64 " %7.2f%% %12.3f  0x%016" PRIx64 "%s\n", slots[i]->entries,
+                slots[i]->blockInstructions, percentOf(slots[i]->blockInstructions, profile->instructions),
+                slots[i]->nanoseconds / NS_PER_MS, slots[i]->pc, location);
+    }
+
+    if (symbols != NULL) {
+        // Put each instruction, and each block's time, down to the label it falls under; the last is for neither.
+        size_t labels = symbols->labelCount;
+        uint64_t *instructions = calloc(labels + 1, sizeof(uint64_t));
+        uint64_t *nanoseconds = calloc(labels + 1, sizeof(uint64_t));
+        assertFatal(instructions != NULL && nanoseconds != NULL, "<Profile> Unable to allocate label totals!");
+
+        for (size_t i = 0; i < count; i++) {
+            const struct SymbolLabel *label = findLabel(symbols, slots[i]->pc);
+            size_t index = label == NULL ? labels : (size_t) (label - symbols->labels);
+            instructions[index] += slots[i]->count;
+            nanoseconds[index] += slots[i]->nanoseconds;
+        }
+
+        fprintf(out, "\nLabels, by instructions executed:\n");
+        fprintf(out, "%14s %8s %12s  %s\n", "instructions", "%", "time (ms)", "label");
+        while (true) {
+            size_t hottest = 0;
+            for (size_t i = 1; i <= labels; i++) {
+                if (instructions[i] > instructions[hottest]) hottest = i;
+            }
+            if (instructions[hottest] == 0) break;
+
+            fprintf(out, "%14" PRIu64 " %7.2f%% %12.3f  %s\n", instructions[hottest],
+                    percentOf(instructions[hottest], profile->instructions), nanoseconds[hottest] / NS_PER_MS,
+                    hottest == labels ? UNLABELLED : symbols->labels[hottest].name);
+            instructions[hottest] = 0;
+        }
+
+        free(instructions);
+        free(nanoseconds);
+    }
+
+    free(slots);
+}
+
+/// Writes the profile as folded stacks, one line per instruction, as taken by flame graph tools.
+/// @param profile The profile.
+/// @param symbols The symbols of the program run, or NULL if there are none.
+/// @param out The file to write to.
+/// @remark With symbols, each instruction is stacked under its label, and named by its source line; without, it is
+/// named by its address alone.
+void writeFoldedStacks(Profile profile, Symbols symbols, FILE *out) {
+    size_t count;
+    ProfileSlot **slots = sortSlots(profile, byAddress, &count);
+
+    for (size_t i = 0; i < count; i++) {
+        BitData pc = slots[i]->pc;
+        if (symbols != NULL) {
+            const struct SymbolLabel *label = findLabel(symbols, pc);
+            const struct SymbolLine *line = findLine(symbols, pc);
+            fprintf(out, "%s;", label == NULL ? UNLABELLED : label->name);
+            if (line != NULL) {
+                fprintf(out, "%s:%zu", symbols->source, line->number);
+            } else {
+                fprintf(out, "0x%" PRIx64, pc);
+            }
+        } else {
+            fprintf(out, "0x%" PRIx64, pc);
+        }
+
+        fprintf(out, " %" PRIu64 "\n", slots[i]->count);
+    }
+
+    free(slots);
+}
+
+/// Frees the given profile.
+/// @param profile The profile.
+void freeProfile(Profile profile) {
+    free(profile->slots);
+    free(profile);
+}
+
+/// Counts an instruction which has executed, and the basic block it is in.
+/// @param context The profile.
+/// @param registers The virtual registers, as the instruction left them.
+/// @param memory The virtual memory.
+/// @param pc The address of the instruction.
+/// @param word The instruction.
+static void profileRetire(void *context, const Registers_s *registers, Memory memory, BitData pc, Instruction word) {
+    Profile profile = context;
+
+    bool entered = profile->blockEnded;
+    if (entered) profile->block = pc;
+
+    ProfileSlot *slot = findSlot(profile, pc);
+    slot->count++;
+    if (entered) slot->entries++;
+
+    // Looked up again, as finding [pc] may have grown the table.
+    findSlot(profile, profile->block)->blockInstructions++;
+    profile->instructions++;
+
+    // A branch ends its block even if not taken, as does any jump.
+    IR *ir = getCachedIR(memory, pc);
+    IRType type = ir != NULL ? ir->type : getDecodeFunction(word)(word).type;
+    profile->blockEnded = type == BRANCH || getRegPC(registers) != pc + WORD_SIZE;
+
+    if (++profile->sinceSample == PROFILE_SAMPLE_INTERVAL) sampleClock(profile);
+}
+
+/// Samples the clock, putting the time since it was last sampled down to the basic block executing.
+/// @param profile The profile.
+static void sampleClock(Profile profile) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    uint64_t elapsed = (uint64_t) (now.tv_sec - profile->lastSample.tv_sec) * 1000000000
+                       + now.tv_nsec - profile->lastSample.tv_nsec;
+    profile->lastSample = now;
+    profile->sinceSample = 0;
+
+    if (profile->instructions == 0) return;
+    findSlot(profile, profile->block)->nanoseconds += elapsed;
+    profile->nanoseconds += elapsed;
+}
+
+/// Finds the slot of the instruction at [pc], claiming one if it has none, and growing the table if it is half full.
+/// @param profile The profile.
+/// @param pc The address of the instruction.
+/// @returns The slot, valid until the next call.
+static ProfileSlot *findSlot(Profile profile, BitData pc) {
+    if (profile->used * 2 >= profile->capacity) {
+        ProfileSlot *old = profile->slots;
+        size_t oldCapacity = profile->capacity;
+
+        profile->capacity *= 2;
+        profile->slots = calloc(profile->capacity, sizeof(ProfileSlot));
+        assertFatalNotNull(profile->slots, "<Profile> Unable to grow slots!");
+        profile->used = 0;
+
+        for (size_t i = 0; i < oldCapacity; i++) {
+            if (old[i].used) *findSlot(profile, old[i].pc) = old[i];
+        }
+        free(old);
+    }
+
+    // Fibonacci hashing of the word index spreads out runs of consecutive instructions.
+    size_t mask = profile->capacity - 1;
+    size_t index = (size_t) ((pc / WORD_SIZE) * 0x9E3779B97F4A7C15ULL >> 32) & mask;
+    while (profile->slots[index].used && profile->slots[index].pc != pc) index = (index + 1) & mask;
+
+    ProfileSlot *slot = &profile->slots[index];
+    if (!slot->used) {
+        *slot = (ProfileSlot) { .used = true, .pc = pc };
+        profile->used++;
+    }
+
+    return slot;
+}
+
+/// Lists the slots in use, sorted.
+/// @param profile The profile.
+/// @param compare How to sort the slots, as by [qsort], given pointers to them.
+/// @param count Set to the number of slots listed.
+/// @returns The list, to be freed.
+static ProfileSlot **sortSlots(Profile profile, int (*compare)(const void *, const void *), size_t *count) {
+    ProfileSlot **slots = malloc((profile->used + 1) * sizeof(ProfileSlot *));
+    assertFatalNotNull(slots, "<Profile> Unable to allocate sorted slots!");
+
+    *count = 0;
+    for (size_t i = 0; i < profile->capacity; i++) {
+        if (profile->slots[i].used) slots[(*count)++] = &profile->slots[i];
+    }
+
+    qsort(slots, *count, sizeof(ProfileSlot *), compare);
+    return slots;
+}
+
+/// Describes where an instruction is in the program's source, as its label, offset and line, after a gap.
+/// @param symbols The symbols of the program run, or NULL if there are none.
+/// @param pc The address of the instruction.
+/// @param buffer The buffer to write the description to, empty without [symbols].
+/// @param size The size of [buffer].
+static void describe(Symbols symbols, BitData pc, char *buffer, size_t size) {
+    buffer[0] = '\0';
+    if (symbols == NULL) return;
+
+    const struct SymbolLabel *label = findLabel(symbols, pc);
+    const struct SymbolLine *line = findLine(symbols, pc);
+
+    int length = label == NULL ? snprintf(buffer, size, "  %s", UNLABELLED)
+                               : snprintf(buffer, size, "  %s+0x%" PRIx64, label->name, pc - label->address);
+    if (line != NULL && length >= 0 && (size_t) length < size) {
+        snprintf(buffer + length, size - length, " (%s:%zu)", symbols->source, line->number);
+    }
+}
+
+/// Works out what percentage [part] is of [whole].
+/// @param part The part.
+/// @param whole The whole, which may be 0.
+/// @returns The percentage, or 0 if [whole] is 0.
+static double percentOf(uint64_t part, uint64_t whole) {
+    return whole == 0 ? 0 : 100.0 * part / whole;
+}
+
+/// Orders slots by how often their instructions executed, most first, then by address.
+/// @param a Pointer to the first slot pointer.
+/// @param b Pointer to the second slot pointer.
+/// @returns Negative, zero or positive, as by [qsort].
+static int byCount(const void *a, const void *b) {
+    const ProfileSlot *x = *(ProfileSlot *const *) a, *y = *(ProfileSlot *const *) b;
+    if (x->count != y->count) return x->count < y->count ? 1 : -1;
+    return byAddress(a, b);
+}
+
+/// Orders slots by how many instructions executed in the basic blocks entered at them, most first, then by address.
+/// @param a Pointer to the first slot pointer.
+/// @param b Pointer to the second slot pointer.
+/// @returns Negative, zero or positive, as by [qsort].
+static int byBlockInstructions(const void *a, const void *b) {
+    const ProfileSlot *x = *(ProfileSlot *const *) a, *y = *(ProfileSlot *const *) b;
+    if (x->blockInstructions != y->blockInstructions) return x->blockInstructions < y->blockInstructions ? 1 : -1;
+    return byAddress(a, b);
+}
+
+/// Orders slots by address.
+/// @param a Pointer to the first slot pointer.
+/// @param b Pointer to the second slot pointer.
+/// @returns Negative, zero or positive, as by [qsort].
+static int byAddress(const void *a, const void *b) {
+    const ProfileSlot *x = *(ProfileSlot *const *) a, *y = *(ProfileSlot *const *) b;
+    return (x->pc > y->pc) - (x->pc < y->pc);
+}
@@ -0,0 +1,105 @@
+///
+/// profile.h
+/// Counts how often each instruction and basic block of a run executes, and roughly where its time goes.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_PROFILE_H
+#define EMULATOR_PROFILE_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "const.h"
+#include "emulatorDelegate.h"
+#include "error.h"
+#include "hooks.h"
+#include "memory.h"
+#include "registers.h"
+#include "symbols.h"
+
+/// The number of slots a [Profile] starts with. Must be a power of two.
+#define PROFILE_INITIAL_SLOTS   1024
+
+/// The number of instructions between samples of the clock; prime, so that samples do not keep landing on the same
+/// instruction of a loop whose length divides it.
+#define PROFILE_SAMPLE_INTERVAL 1021
+
+/// What was counted of the instruction at one address.
+typedef struct {
+    /// Whether the slot is in use.
+    bool used;
+
+    /// The address of the instruction.
+    BitData pc;
+
+    /// The number of times it was executed.
+    uint64_t count;
+
+    /// The number of times a basic block was entered at it.
+    uint64_t entries;
+
+    /// The number of instructions executed in the basic blocks entered at it.
+    uint64_t blockInstructions;
+
+    /// The time sampled in the basic blocks entered at it, in nanoseconds.
+    uint64_t nanoseconds;
+} ProfileSlot;
+
+/// A profile of a run.
+/// @remark Basic blocks are found as the run goes: one starts where the run does, and after each branch or jump, so a
+/// block entered at one address which falls through into a loop is counted apart from the loop itself. Every
+/// [PROFILE_SAMPLE_INTERVAL] instructions, the time since the last sample is put down to the block executing.
+typedef struct {
+    /// An open-addressed hash table of slots, by address.
+    ProfileSlot *slots;
+
+    /// The number of [slots]; a power of two.
+    size_t capacity;
+
+    /// The number of [slots] in use.
+    size_t used;
+
+    /// The address the basic block executing was entered at.
+    BitData block;
+
+    /// Whether the last instruction ended its basic block, so that the next starts one.
+    bool blockEnded;
+
+    /// The number of instructions executed since the clock was last sampled.
+    uint64_t sinceSample;
+
+    /// When the clock was last sampled.
+    struct timespec lastSample;
+
+    /// The number of instructions executed in all.
+    uint64_t instructions;
+
+    /// The time sampled in all, in nanoseconds.
+    uint64_t nanoseconds;
+
+    /// The memory whose instructions are counted.
+    Memory memory;
+} Profile_s;
+
+/// Type definition of a pointer to [Profile_s].
+typedef Profile_s *Profile;
+
+Profile startProfile(Memory memory);
+
+void stopProfile(Profile profile);
+
+void writeProfile(Profile profile, Symbols symbols, FILE *out);
+
+void writeFoldedStacks(Profile profile, Symbols symbols, FILE *out);
+
+void freeProfile(Profile profile);
+
+#endif // EMULATOR_PROFILE_H
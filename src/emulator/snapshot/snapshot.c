@@ -0,0 +1,120 @@
+///
+/// snapshot.c
+/// Captures and restores the state of a run, so that it can be resumed from the same point any number of times.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "snapshot.h"
+
+/// Captures the current state of a run.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @returns The snapshot, to be freed by [freeSnapshot].
+/// @remark Only pages written to since the binary was loaded (or memory last reset) are copied.
+Snapshot takeSnapshot(Registers registers, Memory memory) {
+    Snapshot snapshot = malloc(sizeof(Snapshot_s));
+    assertFatalNotNull(snapshot, "<Snapshot> Unable to allocate [Snapshot_s]!");
+
+    snapshot->registers = *registers;
+    snapshot->binarySize = memory->binarySize;
+    snapshot->binaryHash = memory->binaryHash;
+    snapshot->pages = NULL;
+    snapshot->pageCount = 0;
+
+    size_t capacity = 0;
+    BitData addr = 0;
+    const uint8_t *bytes;
+    while ((bytes = nextWrittenPage(memory, &addr)) != NULL) {
+        if (snapshot->pageCount == capacity) {
+            capacity = capacity == 0 ? 16 : capacity * 2;
+            snapshot->pages = realloc(snapshot->pages, capacity * sizeof(SnapshotPage));
+            assertFatalNotNull(snapshot->pages, "<Snapshot> Unable to allocate [SnapshotPage]s!");
+        }
+
+        SnapshotPage *page = &snapshot->pages[snapshot->pageCount++];
+        page->address = addr;
+        memcpy(page->bytes, bytes, MEMORY_PAGE_SIZE);
+        addr += MEMORY_PAGE_SIZE;
+    }
+
+    return snapshot;
+}
+
+/// Restores the state captured by [snapshot], so that running on continues exactly as it did from there.
+/// @param snapshot The snapshot.
+/// @param registers The virtual registers to restore.
+/// @param memory The virtual memory to restore, loaded from the same binary as [snapshot] was taken from.
+/// @remark Memory is reset, then the snapshot's pages written back, so restoring costs in proportion to the pages
+/// written since loading (or the last restore) and those in the snapshot, not to the size of memory. Decoded code is
+/// discarded, and devices are left as they are.
+void restoreSnapshot(Snapshot snapshot, Registers registers, Memory memory) {
+    assertFatal(snapshot->binarySize == memory->binarySize && snapshot->binaryHash == memory->binaryHash,
+                "Snapshot was taken of a run of a different binary!");
+
+    resetMem(memory);
+    for (size_t i = 0; i < snapshot->pageCount; i++) {
+        writePage(memory, snapshot->pages[i].address, snapshot->pages[i].bytes);
+    }
+
+    *registers = snapshot->registers;
+}
+
+/// Writes [snapshot] to a file.
+/// @param snapshot The snapshot.
+/// @param path The path of the file.
+/// @remark The file is only meant to be loaded by this same build of the emulator, on the same host.
+void saveSnapshot(Snapshot snapshot, const char *path) {
+    FILE *file = fopen(path, "wb");
+    assertFatalNotNullWithArgs(file, "Unable to open snapshot file '%s'!", path);
+
+    uint64_t header[] = {
+        sizeof(Registers_s), MEMORY_PAGE_SIZE, snapshot->binarySize, snapshot->binaryHash, snapshot->pageCount
+    };
+    bool written = fwrite(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC) - 1, 1, file) == 1
+                   && fwrite(header, sizeof(header), 1, file) == 1
+                   && fwrite(&snapshot->registers, sizeof(Registers_s), 1, file) == 1
+                   && fwrite(snapshot->pages, sizeof(SnapshotPage), snapshot->pageCount, file) == snapshot->pageCount;
+
+    assertFatalWithArgs(fclose(file) == 0 && written, "Unable to write snapshot file '%s'!", path);
+}
+
+/// Reads a snapshot from a file written by [saveSnapshot].
+/// @param path The path of the file.
+/// @returns The snapshot, to be freed by [freeSnapshot].
+Snapshot loadSnapshot(const char *path) {
+    FILE *file = fopen(path, "rb");
+    assertFatalNotNullWithArgs(file, "Unable to open snapshot file '%s'!", path);
+
+    char magic[sizeof(SNAPSHOT_MAGIC) - 1];
+    uint64_t header[5];
+    bool valid = fread(magic, sizeof(magic), 1, file) == 1 && memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0
+                 && fread(header, sizeof(header), 1, file) == 1
+                 && header[0] == sizeof(Registers_s) && header[1] == MEMORY_PAGE_SIZE;
+    if (!valid) fclose(file);
+    assertFatalWithArgs(valid, "'%s' is not a snapshot taken by this emulator!", path);
+
+    Snapshot snapshot = malloc(sizeof(Snapshot_s));
+    assertFatalNotNull(snapshot, "<Snapshot> Unable to allocate [Snapshot_s]!");
+
+    snapshot->binarySize = header[2];
+    snapshot->binaryHash = header[3];
+    snapshot->pageCount = header[4];
+    snapshot->pages = malloc(snapshot->pageCount * sizeof(SnapshotPage));
+    assertFatal(snapshot->pages != NULL || snapshot->pageCount == 0, "<Snapshot> Unable to allocate [SnapshotPage]s!");
+
+    bool read = fread(&snapshot->registers, sizeof(Registers_s), 1, file) == 1
+                && fread(snapshot->pages, sizeof(SnapshotPage), snapshot->pageCount, file) == snapshot->pageCount;
+    fclose(file);
+
+    if (!read) freeSnapshot(snapshot);
+    assertFatalWithArgs(read, "Snapshot file '%s' is truncated!", path);
+    return snapshot;
+}
+
+/// Frees the given snapshot.
+/// @param snapshot The snapshot.
+void freeSnapshot(Snapshot snapshot) {
+    free(snapshot->pages);
+    free(snapshot);
+}
@@ -0,0 +1,68 @@
+///
+/// snapshot.h
+/// Captures and restores the state of a run, so that it can be resumed from the same point any number of times.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_SNAPSHOT_H
+#define EMULATOR_SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "const.h"
+#include "error.h"
+#include "memory.h"
+#include "registers.h"
+
+/// The magic number a snapshot file starts with, followed by its format version.
+#define SNAPSHOT_MAGIC "A64SNAP\x02"
+
+/// A page of memory captured by a snapshot.
+typedef struct {
+    /// The address of the page.
+    BitData address;
+
+    /// The contents of the page.
+    uint8_t bytes[MEMORY_PAGE_SIZE];
+} SnapshotPage;
+
+/// The state of a run at some point: its registers, and every page of memory written to since the binary was loaded.
+/// @remark Every other page still holds what was loaded, so is left out; a snapshot is only restored over memory
+/// loaded from the same binary it was taken from, as told by [binarySize] and [binaryHash].
+typedef struct {
+    /// The registers.
+    Registers_s registers;
+
+    /// The [Memory_s.binarySize] of the memory the snapshot was taken of.
+    uint64_t binarySize;
+
+    /// The [Memory_s.binaryHash] of the memory the snapshot was taken of.
+    uint64_t binaryHash;
+
+    /// The pages written to, in address order.
+    SnapshotPage *pages;
+
+    /// The number of [pages].
+    size_t pageCount;
+} Snapshot_s;
+
+/// Type definition of a pointer to [Snapshot_s].
+typedef Snapshot_s *Snapshot;
+
+Snapshot takeSnapshot(Registers registers, Memory memory);
+
+void restoreSnapshot(Snapshot snapshot, Registers registers, Memory memory);
+
+void saveSnapshot(Snapshot snapshot, const char *path);
+
+Snapshot loadSnapshot(const char *path);
+
+void freeSnapshot(Snapshot snapshot);
+
+#endif // EMULATOR_SNAPSHOT_H
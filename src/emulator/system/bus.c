@@ -0,0 +1,90 @@
+///
+/// bus.c
+/// The peripheral bus, routing accesses to registered address ranges to device models.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "bus.h"
+
+/// Serialises accesses to devices, whose models are not themselves safe to access from several cores at once.
+static pthread_mutex_t deviceLock = PTHREAD_MUTEX_INITIALIZER;
+
+/// Attaches [device] to [bus], so that accesses to its registers are routed to it.
+/// @param bus The bus.
+/// @param device The device to attach.
+void attachDevice(Bus *bus, Device device) {
+    assertFatal(bus->count < MAX_DEVICES, "<Bus> Too many devices!");
+    assertFatal(device.size != 0 && device.base + device.size > device.base, "<Bus> Invalid device range!");
+
+    for (size_t i = 0; i < bus->count; i++) {
+        Device *other = &bus->devices[i];
+        assertFatal(device.base + device.size <= other->base || other->base + other->size <= device.base,
+                    "<Bus> Overlapping devices!");
+    }
+
+    // Widen the bounds of every device to take in the new one.
+    BitData end = device.base + device.size;
+    if (bus->count != 0) end = end > bus->base + bus->span ? end : bus->base + bus->span;
+    if (bus->count == 0 || device.base < bus->base) bus->base = device.base;
+    bus->span = end - bus->base;
+
+    bus->devices[bus->count++] = device;
+}
+
+/// Finds the device whose registers contain [addr].
+/// @param bus The bus.
+/// @param addr The address accessed.
+/// @returns The device, or NULL if [addr] is plain memory.
+Device *findDevice(Bus *bus, BitData addr) {
+    for (size_t i = 0; i < bus->count; i++) {
+        Device *device = &bus->devices[i];
+        if (addr - device->base < device->size) return device;
+    }
+    return NULL;
+}
+
+/// Reads 64/32-bits from the registers of [device].
+/// @param device The device.
+/// @param as64 Whether to read 64 or 32 bits.
+/// @param addr The address accessed.
+/// @returns The value read.
+/// @remark Registers are 32 bits wide, so a 64-bit access reads two adjacent registers, low one first.
+BitData readDevice(Device *device, bool as64, BitData addr) {
+    size_t offset = addr - device->base;
+    assertFatal(offset % DEVICE_WORD_SIZE == 0, "<Bus> Received misaligned access to device!");
+    assertFatal(offset + (as64 ? 2 : 1) * DEVICE_WORD_SIZE <= device->size, "<Bus> Access runs off end of device!");
+
+    pthread_mutex_lock(&deviceLock);
+    BitData result = device->read(device->state, offset);
+    if (as64) result |= (BitData) device->read(device->state, offset + DEVICE_WORD_SIZE) << 32;
+    pthread_mutex_unlock(&deviceLock);
+    return result;
+}
+
+/// Writes 64/32-bits to the registers of [device].
+/// @param device The device.
+/// @param as64 Whether to write 64 or 32 bits.
+/// @param addr The address accessed.
+/// @param value The value to write.
+/// @remark Registers are 32 bits wide, so a 64-bit access writes two adjacent registers, low one first.
+void writeDevice(Device *device, bool as64, BitData addr, BitData value) {
+    size_t offset = addr - device->base;
+    assertFatal(offset % DEVICE_WORD_SIZE == 0, "<Bus> Received misaligned access to device!");
+    assertFatal(offset + (as64 ? 2 : 1) * DEVICE_WORD_SIZE <= device->size, "<Bus> Access runs off end of device!");
+
+    pthread_mutex_lock(&deviceLock);
+    device->write(device->state, offset, (uint32_t) value);
+    if (as64) device->write(device->state, offset + DEVICE_WORD_SIZE, (uint32_t) (value >> 32));
+    pthread_mutex_unlock(&deviceLock);
+}
+
+/// Detaches and frees every device of [bus].
+/// @param bus The bus.
+void destroyBus(Bus *bus) {
+    for (size_t i = 0; i < bus->count; i++) {
+        if (bus->devices[i].destroy != NULL) bus->devices[i].destroy(bus->devices[i].state);
+    }
+
+    *bus = (Bus) { .count = 0, .base = 0, .span = 0 };
+}
@@ -0,0 +1,93 @@
+///
+/// bus.h
+/// The peripheral bus, routing accesses to registered address ranges to device models.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_BUS_H
+#define EMULATOR_BUS_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "const.h"
+#include "error.h"
+
+/// The most devices which may be attached to one bus.
+#define MAX_DEVICES       8
+
+/// The number of bytes in one register of a device.
+#define DEVICE_WORD_SIZE  sizeof(uint32_t)
+
+/// Reads a register of a device.
+/// @param state The state of the device.
+/// @param offset The offset of the register from the base of the device.
+/// @returns The value of the register.
+typedef uint32_t (*DeviceRead)(void *state, size_t offset);
+
+/// Writes a register of a device.
+/// @param state The state of the device.
+/// @param offset The offset of the register from the base of the device.
+/// @param value The value written.
+typedef void (*DeviceWrite)(void *state, size_t offset, uint32_t value);
+
+/// A model of a memory-mapped peripheral.
+typedef struct {
+    /// The first address of the device's registers.
+    BitData base;
+
+    /// The number of bytes of the device's registers.
+    size_t size;
+
+    /// The state of the device, passed to its handlers.
+    void *state;
+
+    /// The handler of reads from the device.
+    DeviceRead read;
+
+    /// The handler of writes to the device.
+    DeviceWrite write;
+
+    /// Frees [state], or NULL if there is nothing to free.
+    void (*destroy)(void *state);
+} Device;
+
+/// The devices attached to a chunk of virtual memory.
+/// @remark [base] and [span] bound every device, so that an access outside of all of them is ruled out by a single
+/// unsigned comparison; with no devices, [span] is 0 and that comparison never holds.
+typedef struct {
+    /// The attached devices.
+    Device devices[MAX_DEVICES];
+
+    /// The number of [devices].
+    size_t count;
+
+    /// The lowest address of any device.
+    BitData base;
+
+    /// The number of bytes from [base] to the end of the highest device.
+    uint64_t span;
+} Bus;
+
+/// Checks whether [addr] may belong to a device on [bus].
+/// @param bus The bus.
+/// @param addr The address accessed.
+/// @returns False if [addr] is definitely plain memory.
+static inline bool onBus(const Bus *bus, BitData addr) {
+    return addr - bus->base < bus->span;
+}
+
+void attachDevice(Bus *bus, Device device);
+
+Device *findDevice(Bus *bus, BitData addr);
+
+BitData readDevice(Device *device, bool as64, BitData addr);
+
+void writeDevice(Device *device, bool as64, BitData addr, BitData value);
+
+void destroyBus(Bus *bus);
+
+#endif // EMULATOR_BUS_H
@@ -6,12 +6,60 @@
 ///
 
 #include "memory.h"
+#include "blockCache.h"
+#include "hooks.h"
+#include "threaded.h"
+
+/// The contents of every page which has not been written to.
+static const uint8_t zeroPage[MEMORY_PAGE_SIZE];
+
+/// The start of the guard region of every fast memory, or NULL for unused entries.
+/// @remark Entries are claimed and released atomically, as fast memories may be created on any thread.
+static uint8_t *guards[MAX_FAST_MEMORIES];
+
+/// Ensures [guardFault] is installed exactly once.
+static pthread_once_t guardHandling = PTHREAD_ONCE_INIT;
+
+static Memory createMem(void);
+
+static Memory createFastMem(void);
+
+static uint64_t hashBinary(const uint8_t *bytes, size_t size);
+
+static void handleGuardFaults(void);
+
+static void guardFault(int signal, siginfo_t *info, void *context);
+
+static Page *findPage(Memory memory, size_t addr, bool allocate);
+
+static void freeTable(Memory memory, void **table, size_t level);
+
+static bool resetTable(Memory memory, void **table, size_t level);
+
+static bool inImage(Memory memory, const uint8_t *bytes);
+
+static void invalidateDecoded(Memory memory, size_t addr, size_t size);
+
+static void markWritten(Memory memory, size_t addr, size_t size);
+
+static void recordWritten(Memory memory, size_t page);
+
+static void discardTable(void **table, size_t level);
+
+static BitData loadMem(Memory memory, bool as64, size_t addr);
+
+static bool isDevice(Memory memory, size_t addr);
+
+static void hookWrite(Memory memory, bool as64, size_t addr, BitData old, BitData value);
 
 /// Allocates a chunk of virtual memory preloaded with the contents of the given file handler.
 /// @param fd File handler of initial contents.
+/// @param mode The backend of the virtual memory.
 /// @returns Generic pointer to memory.
 /// @pre No errors occurred when the file handler [fd] was created.
-Memory allocMemFromFile(char *path) {
+/// @remark The file is mapped privately rather than read, so only the pages the guest touches are ever loaded,
+/// and only those it writes to are copied.
+Memory allocMemFromFile(char *path, MemoryMode mode) {
     // Open the file
     int fd = open(path, O_RDONLY);
 
@@ -19,17 +67,36 @@ Memory allocMemFromFile(char *path) {
     struct stat sb;
     assertFatal(fstat(fd, &sb) == 0, "Unable to get statistics on file!");
 
-    // Must have enough space to store file.
-    assertFatal(sb.st_size <= MEMORY_SIZE, "Virtual memory not big enough for binary file!");
+    // Allocate memory, which must have enough space to store file.
+    Memory memory = mode == FAST_MEMORY ? createFastMem() : createMem();
+    assertFatal((uint64_t) sb.st_size <= memory->size, "Virtual memory not big enough for binary file!");
+
+    // Map file into the beginning, rounded up to whole host pages, whose tails the host fills with zeroes.
+    size_t hostPage = sysconf(_SC_PAGESIZE);
+    size_t imageSize = (sb.st_size + hostPage - 1) / hostPage * hostPage;
+    if (imageSize != 0) {
+        int flags = MAP_PRIVATE | (memory->window != NULL ? MAP_FIXED : 0);
+        uint8_t *image = mmap(memory->window, imageSize, PROT_READ | PROT_WRITE, flags, fd, 0);
+        assertFatal(image != MAP_FAILED, "<Memory> Something went wrong during mapping-in of binary file!");
 
-    // Allocate memory.
-    Memory memory = mmap(NULL, MEMORY_SIZE, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
-    assertFatal(memory != MAP_FAILED, "<Memory> Unable to allocate memory!");
+        if (memory->window == NULL) {
+            memory->image = image;
+            memory->imageSize = imageSize;
+        }
 
-    // Zero out rest of memory, then read file into beginning.
-    memset(memory, 0, MEMORY_SIZE);
-    ssize_t bytes_read = pread(fd, memory, sb.st_size, 0);
-    assertFatal(bytes_read == sb.st_size, "<Memory> Something went wrong during reading-in of binary file!");
+        // Reading the mapping only faults in the file's pages, without copying them.
+        memory->binarySize = sb.st_size;
+        memory->binaryHash = hashBinary(image, sb.st_size);
+    }
+
+    // Enter every page of the file, so that it is dumped; the rest of memory reads as zero.
+    for (size_t offset = 0; offset < (size_t) sb.st_size; offset += MEMORY_PAGE_SIZE) {
+        if (memory->window != NULL) {
+            memory->pageFlags[offset >> PAGE_BITS] |= PAGE_LOADED;
+        } else {
+            findPage(memory, offset, true);
+        }
+    }
 
     close(fd);
 
@@ -38,21 +105,108 @@ Memory allocMemFromFile(char *path) {
 
 /// Allocates a chunk of blank virtual memory.
 /// @return Generic pointer to memory.
+/// @remark No page is allocated until it is written to, so there is nothing to zero.
 Memory allocMem(void) {
-    Memory memory = mmap(NULL, MEMORY_SIZE, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
-    assertFatalNotNull(memory, "<Memory> Unable to allocate memory!");
+    return createMem();
+}
 
-    // Zero out rest of memory.
-    uint8_t *ptr = memory;
-    while (ptr != (uint8_t *) memory + MEMORY_SIZE) *ptr++ = 0;
+/// Creates a view of the given fast memory, sharing its contents and devices but with its own decoded instructions
+/// and blocks, so that each of several host threads can run code from the same memory through its own view.
+/// @param shared The fast memory to share.
+/// @returns The view, to be freed by [freeMem] before [shared] is.
+/// @remark A write through one view does not invalidate code decoded by another; as on hardware, a core only sees
+/// code modified by another once it executes an \code isb \endcode, see [discardDecoded].
+Memory createMemView(Memory shared) {
+    assertFatal(shared->window != NULL && shared->shared == NULL, "<Memory> Only fast memory can be shared!");
 
+    Memory memory = createMem();
+    memory->size = shared->size;
+    memory->window = shared->window;
+    memory->pageFlags = shared->pageFlags;
+    memory->writtenPages = shared->writtenPages;
+    memory->binarySize = shared->binarySize;
+    memory->binaryHash = shared->binaryHash;
+    memory->bus = shared->bus;
+    memory->shared = shared;
     return memory;
 }
 
 /// Frees the given chunk of virtual memory.
 /// @param memory Generic pointer to virtual memory to free.
 void freeMem(Memory memory) {
-    assertFatal(munmap(memory, MEMORY_SIZE) == 0, "<Memory> Unable to un-map memory!");
+    freeTable(memory, memory->pageTable, 0);
+    free(memory->hooks);
+
+    if (memory->shared != NULL) {
+        // The contents and devices of a view belong to the memory it shares.
+        if (memory->blocks != NULL) destroyBlockCache(memory->blocks);
+        if (memory->threaded != NULL) destroyThreadedCode(memory->threaded);
+        free(memory);
+        return;
+    }
+
+    if (memory->image != NULL) {
+        assertFatal(munmap(memory->image, memory->imageSize) == 0, "<Memory> Unable to un-map binary file!");
+    }
+
+    if (memory->window != NULL) {
+        for (size_t i = 0; i < MAX_FAST_MEMORIES; i++) {
+            uint8_t *guard = memory->window + FAST_MEMORY_SIZE;
+            __atomic_compare_exchange_n(&guards[i], &guard, NULL, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+        }
+
+        assertFatal(munmap(memory->window, FAST_MEMORY_SIZE + GUARD_SIZE) == 0, "<Memory> Unable to un-map memory!");
+        assertFatal(munmap(memory->pageFlags, FAST_MEMORY_SIZE >> PAGE_BITS) == 0,
+                    "<Memory> Unable to un-map page flags!");
+        assertFatal(munmap(memory->writtenPages, (FAST_MEMORY_SIZE >> PAGE_BITS) * sizeof(uint32_t)) == 0,
+                    "<Memory> Unable to un-map written pages!");
+    }
+
+    if (memory->blocks != NULL) destroyBlockCache(memory->blocks);
+    if (memory->threaded != NULL) destroyThreadedCode(memory->threaded);
+    destroyBus(&memory->bus);
+    free(memory);
+}
+
+/// Resets the given chunk of virtual memory to how it was allocated, i.e., blank but for the loaded binary.
+/// @param memory The address of the virtual memory.
+/// @remark Only pages written to since loading (or the last reset) are touched: private copies of the binary's
+/// pages are dropped so that they are mapped from the file again, and every other page is released. Decoded
+/// instructions, blocks and threaded code are discarded. So a reset costs in proportion to the pages written, not
+/// the size of memory.
+void resetMem(Memory memory) {
+    if (resetTable(memory, memory->pageTable, 0)) {
+        memory->pageTable = calloc(TABLE_ENTRIES, sizeof(void *));
+        assertFatalNotNull(memory->pageTable, "<Memory> Unable to allocate page table!");
+    }
+
+    if (memory->window != NULL) {
+        size_t hostPage = sysconf(_SC_PAGESIZE);
+
+        for (size_t i = 0; i < memory->writtenCount; i++) {
+            size_t page = memory->writtenPages[i];
+            memory->pageFlags[page] &= ~PAGE_WRITTEN;
+
+            size_t start = (page << PAGE_BITS) / hostPage * hostPage;
+            size_t end = (((page + 1) << PAGE_BITS) + hostPage - 1) / hostPage * hostPage;
+            assertFatal(madvise(memory->window + start, end - start, MADV_DONTNEED) == 0,
+                        "<Memory> Unable to reset memory!");
+        }
+        memory->writtenCount = 0;
+    }
+
+    memory->lastPage = NULL;
+    memory->codeVersion++;
+
+    if (memory->blocks != NULL) {
+        destroyBlockCache(memory->blocks);
+        memory->blocks = NULL;
+    }
+
+    if (memory->threaded != NULL) {
+        destroyThreadedCode(memory->threaded);
+        memory->threaded = NULL;
+    }
 }
 
 /// Reads 64/32-bits from virtual memory. If 32-bits is selected, higher bits will be set to 0.
@@ -60,17 +214,34 @@ void freeMem(Memory memory) {
 /// @param as64 Whether to read 64 or 32 bits.
 /// @param addr The address within the virtual memory.
 /// @returns The 64-bit value at mem + addr.
+/// @remark Reads of a device's registers are routed to the device, see [bus.h]. Every read is seen by the read
+/// hooks attached, if any.
 BitData readMem(Memory memory, bool as64, size_t addr) {
-    size_t readSize = as64 ? sizeof(uint64_t) : sizeof(uint32_t);
-    assertFatal(addr + readSize <= MEMORY_SIZE, "<Memory> Received out-of-bound read to memory!");
-
-    // Read virtual memory as little-endian.
-    uint8_t *ptr = (uint8_t *) memory + addr;
-    uint64_t result = ptr[0];
-    for (size_t i = 1; i < readSize; i++) {
-        result |= ((uint64_t) ptr[i] << i * 8);
+    BitData value = loadMem(memory, as64, addr);
+    if (memory->hooks != NULL) {
+        fireMemoryHooks(memory, &(MemoryAccess) {
+            .as64 = as64, .device = isDevice(memory, addr), .address = addr, .value = value
+        });
     }
-    return result;
+    return value;
+}
+
+/// Reads the instruction at [addr], as [readMem] does, but unseen by any hook; a fetch is not a data access.
+/// @param memory The address of the virtual memory.
+/// @param addr The address within the virtual memory.
+/// @returns The instruction at mem + addr.
+Instruction fetchMem(Memory memory, size_t addr) {
+    return (Instruction) loadMem(memory, false, addr);
+}
+
+/// Reads 64/32-bits from virtual memory without side effects: unseen by any hook, and seeing 0 for a device's
+/// registers rather than reading the device.
+/// @param memory The address of the virtual memory.
+/// @param as64 Whether to read 64 or 32 bits.
+/// @param addr The address within the virtual memory.
+/// @returns The 64-bit value at mem + addr.
+BitData peekMem(Memory memory, bool as64, size_t addr) {
+    return isDevice(memory, addr) ? 0 : loadMem(memory, as64, addr);
 }
 
 /// Writes 64/32-bits to virtual memory. If 32-bits is selected, the higher bits of [value] will be ignored.
@@ -78,12 +249,561 @@ BitData readMem(Memory memory, bool as64, size_t addr) {
 /// @param as64 Whether to write 64 or 32 bits.
 /// @param addr The address within the virtual memory.
 /// @param value The value to write.
+/// @remark Writes to a device's registers are routed to the device, see [bus.h]. Every write is seen by the write
+/// hooks attached, if any, before it lands.
 void writeMem(Memory memory, bool as64, size_t addr, BitData value) {
     size_t writeSize = as64 ? sizeof(uint64_t) : sizeof(uint32_t);
-    assertFatal(addr + writeSize <= MEMORY_SIZE, "Received out-of-bound read to memory!");
 
-    uint8_t *ptr = (uint8_t *) memory + addr;
+    if (onBus(&memory->bus, addr)) {
+        Device *device = findDevice(&memory->bus, addr);
+        if (device != NULL) {
+            if (memory->hooks != NULL) {
+                fireMemoryHooks(memory, &(MemoryAccess) {
+                    .write = true, .as64 = as64, .device = true, .address = addr, .value = value
+                });
+            }
+            writeDevice(device, as64, addr, value);
+            return;
+        }
+    }
+
+    if (memory->window != NULL) {
+        // A single host store; one running off the end of the window faults in the guard region.
+        if (addr >= FAST_MEMORY_SIZE) throwFatal("<Memory> Received out-of-bound write to memory!");
+        if (memory->hooks != NULL) hookWrite(memory, as64, addr, loadMem(memory, as64, addr), value);
+        memcpy(memory->window + addr, &value, writeSize);
+        markWritten(memory, addr, writeSize);
+        return;
+    }
+
+    assertFatal(addr <= ADDRESS_SPACE - writeSize, "Received out-of-bound read to memory!");
+    if (memory->hooks != NULL) hookWrite(memory, as64, addr, loadMem(memory, as64, addr), value);
+
+    // Write virtual memory as little-endian, to at most two pages.
+    uint8_t *ptr = NULL;
     for (size_t i = 0; i < writeSize; i++) {
-        ptr[i] = (uint8_t) (value >> 8 * i);
+        if (i == 0 || (addr + i) % MEMORY_PAGE_SIZE == 0) {
+            Page *page = findPage(memory, addr + i, true);
+            page->dirty = true;
+            ptr = page->bytes;
+        }
+        ptr[(addr + i) % MEMORY_PAGE_SIZE] = (uint8_t) (value >> 8 * i);
+    }
+
+    invalidateDecoded(memory, addr, writeSize);
+}
+
+/// Atomically writes 64/32-bits to virtual memory, but only if they still hold [expected].
+/// @param memory The address of the virtual memory.
+/// @param as64 Whether to write 64 or 32 bits.
+/// @param addr The (naturally aligned) address within the virtual memory.
+/// @param expected The value the memory must hold for the write to happen.
+/// @param value The value to write.
+/// @returns Whether [value] was written.
+/// @remark This is what a store exclusive commits with, so that it is atomic with respect to every other core
+/// running on fast memory from another host thread. Paged memory is only ever run from one thread.
+bool exchangeMem(Memory memory, bool as64, size_t addr, BitData expected, BitData value) {
+    size_t writeSize = as64 ? sizeof(uint64_t) : sizeof(uint32_t);
+    assertFatal(addr % writeSize == 0, "<Memory> Received misaligned exclusive access to memory!");
+
+    if (onBus(&memory->bus, addr) && findDevice(&memory->bus, addr) != NULL) {
+        throwFatal("<Memory> Received exclusive access to device!");
+    }
+
+    if (memory->window == NULL) {
+        if (loadMem(memory, as64, addr) != expected) return false;
+        writeMem(memory, as64, addr, value);
+        return true;
+    }
+
+    if (addr >= FAST_MEMORY_SIZE) throwFatal("<Memory> Received out-of-bound write to memory!");
+
+    bool exchanged;
+    if (as64) {
+        exchanged = __atomic_compare_exchange_n((uint64_t *) (memory->window + addr), &expected, value, false,
+                                                __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    } else {
+        uint32_t expected32 = (uint32_t) expected;
+        exchanged = __atomic_compare_exchange_n((uint32_t *) (memory->window + addr), &expected32, (uint32_t) value,
+                                                false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    }
+
+    if (exchanged) {
+        if (memory->hooks != NULL) hookWrite(memory, as64, addr, expected, value);
+        markWritten(memory, addr, writeSize);
+    }
+    return exchanged;
+}
+
+/// Writes a whole page of virtual memory.
+/// @param memory The address of the virtual memory.
+/// @param addr The (page-aligned) address of the page.
+/// @param bytes The [MEMORY_PAGE_SIZE] bytes to write.
+/// @remark The page counts as written to, exactly as if written by [writeMem]; it must not hold any device.
+void writePage(Memory memory, size_t addr, const uint8_t *bytes) {
+    assertFatal(addr % MEMORY_PAGE_SIZE == 0 && addr < memory->size, "<Memory> Received invalid page to write!");
+
+    if (memory->window != NULL) {
+        memcpy(memory->window + addr, bytes, MEMORY_PAGE_SIZE);
+        markWritten(memory, addr, MEMORY_PAGE_SIZE);
+        return;
+    }
+
+    Page *page = findPage(memory, addr, true);
+    memcpy(page->bytes, bytes, MEMORY_PAGE_SIZE);
+    page->dirty = true;
+    if (page->decoded != NULL) invalidateDecoded(memory, addr, MEMORY_PAGE_SIZE);
+}
+
+/// Gets the cached decoding of the instruction at [addr], if there is one.
+/// @param memory The address of the virtual memory.
+/// @param addr The address of the instruction within the virtual memory.
+/// @returns The cached [IR], or NULL if [addr] has not been decoded since it was last written.
+IR *getCachedIR(Memory memory, size_t addr) {
+    if (addr % WORD_SIZE != 0 || addr >= memory->size) return NULL;
+
+    Page *page = findPage(memory, addr, false);
+    if (page == NULL || page->decoded == NULL) return NULL;
+
+    DecodedSlot *slot = &page->decoded[addr % MEMORY_PAGE_SIZE / WORD_SIZE];
+    return slot->valid ? &slot->ir : NULL;
+}
+
+/// Caches [ir] as the decoding of the instruction at [addr].
+/// @param memory The address of the virtual memory.
+/// @param addr The address of the instruction within the virtual memory.
+/// @param ir The decoded instruction.
+/// @returns The cached [IR], or NULL if [addr] is not a cacheable (word-aligned, in-bound) address.
+IR *cacheIR(Memory memory, size_t addr, IR ir) {
+    if (addr % WORD_SIZE != 0 || addr >= memory->size) return NULL;
+
+    Page *page = findPage(memory, addr, true);
+    if (page->decoded == NULL) {
+        page->decoded = calloc(PAGE_SLOTS, sizeof(DecodedSlot));
+        assertFatalNotNull(page->decoded, "<Memory> Unable to allocate decoded-instruction cache!");
+        if (memory->window != NULL) __atomic_fetch_or(&memory->pageFlags[addr >> PAGE_BITS], PAGE_DECODED,
+                                                      __ATOMIC_RELAXED);
+    }
+
+    DecodedSlot *slot = &page->decoded[addr % MEMORY_PAGE_SIZE / WORD_SIZE];
+    *slot = (DecodedSlot) { .valid = true, .ir = ir };
+    return &slot->ir;
+}
+
+/// Discards every decoded instruction (and so every block) of [memory], so that code is decoded afresh.
+/// @param memory The address of the virtual memory.
+/// @remark Writes invalidate the decodings of the memory written through as they land, so this is only needed by
+/// views made by [createMemView], to pick up code written through another view.
+void discardDecoded(Memory memory) {
+    discardTable(memory->pageTable, 0);
+    memory->codeVersion++;
+}
+
+/// Finds the first page at or after [addr] which has been written to or loaded.
+/// @param memory The address of the virtual memory.
+/// @param addr The address to search from, which is set to the start of the page found.
+/// @returns The contents of the page found, or NULL if there is none.
+const uint8_t *nextPage(Memory memory, BitData *addr) {
+    uint64_t pageNumber = *addr >> PAGE_BITS;
+
+    if (memory->window != NULL) {
+        for (; pageNumber < FAST_MEMORY_SIZE >> PAGE_BITS; pageNumber++) {
+            if (!(memory->pageFlags[pageNumber] & (PAGE_WRITTEN | PAGE_LOADED))) continue;
+
+            *addr = pageNumber << PAGE_BITS;
+            return memory->window + *addr;
+        }
+        return NULL;
     }
+
+    while (pageNumber < ADDRESS_SPACE >> PAGE_BITS) {
+        void **table = memory->pageTable;
+        size_t level = 0;
+        for (; level < TABLE_LEVELS; level++) {
+            size_t shift = (TABLE_LEVELS - 1 - level) * TABLE_BITS;
+            void *entry = table[(pageNumber >> shift) % TABLE_ENTRIES];
+            if (entry == NULL) break;
+            table = entry;
+        }
+
+        if (level == TABLE_LEVELS) {
+            *addr = pageNumber << PAGE_BITS;
+            return ((Page *) table)->bytes;
+        }
+
+        // Skip every page under the missing entry.
+        size_t span = (TABLE_LEVELS - 1 - level) * TABLE_BITS;
+        pageNumber = ((pageNumber >> span) + 1) << span;
+    }
+
+    return NULL;
+}
+
+/// Finds the first page at or after [addr] which has been written to since loading, or memory was last reset.
+/// @param memory The address of the virtual memory.
+/// @param addr The address to search from, which is set to the start of the page found.
+/// @returns The contents of the page found, or NULL if there is none.
+const uint8_t *nextWrittenPage(Memory memory, BitData *addr) {
+    const uint8_t *bytes;
+    while ((bytes = nextPage(memory, addr)) != NULL) {
+        if (memory->window != NULL) {
+            if (memory->pageFlags[*addr >> PAGE_BITS] & PAGE_WRITTEN) return bytes;
+        } else if (findPage(memory, *addr, false)->dirty) {
+            return bytes;
+        }
+        *addr += MEMORY_PAGE_SIZE;
+    }
+    return NULL;
+}
+
+/// Allocates the [Memory_s] and backing mappings for a chunk of virtual memory.
+/// @returns The blank virtual memory, with no pages allocated.
+static Memory createMem(void) {
+    Memory memory = malloc(sizeof(Memory_s));
+    assertFatalNotNull(memory, "<Memory> Unable to allocate [Memory_s]!");
+
+    memory->size = ADDRESS_SPACE;
+    memory->window = NULL;
+    memory->pageFlags = NULL;
+    memory->writtenPages = NULL;
+    memory->writtenCount = 0;
+    memory->image = NULL;
+    memory->imageSize = 0;
+    memory->binarySize = 0;
+    memory->binaryHash = BINARY_HASH_BASIS;
+
+    memory->pageTable = calloc(TABLE_ENTRIES, sizeof(void *));
+    assertFatalNotNull(memory->pageTable, "<Memory> Unable to allocate page table!");
+
+    memory->lastPage = NULL;
+    memory->lastPageNumber = 0;
+    memory->codeVersion = 0;
+    memory->blocks = NULL;
+    memory->threaded = NULL;
+    memory->bus = (Bus) { .count = 0, .base = 0, .span = 0 };
+    memory->shared = NULL;
+    memory->hooks = NULL;
+
+    return memory;
+}
+
+/// Allocates the [Memory_s] and host window for a chunk of fast virtual memory.
+/// @returns The blank virtual memory.
+/// @remark The window is reserved without backing, so the host only allocates (zeroed) pages as they are written.
+static Memory createFastMem(void) {
+    // Values are copied to and from the window in host byte order.
+    assertFatal(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "<Memory> Fast memory needs a little-endian host!");
+
+    Memory memory = createMem();
+    memory->size = FAST_MEMORY_SIZE;
+
+    memory->window = mmap(NULL, FAST_MEMORY_SIZE + GUARD_SIZE, PROT_NONE,
+                          MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE, -1, 0);
+    assertFatal(memory->window != MAP_FAILED, "<Memory> Unable to reserve memory!");
+    assertFatal(mprotect(memory->window, FAST_MEMORY_SIZE, PROT_READ | PROT_WRITE) == 0,
+                "<Memory> Unable to allocate memory!");
+
+    memory->pageFlags = mmap(NULL, FAST_MEMORY_SIZE >> PAGE_BITS, PROT_READ | PROT_WRITE,
+                             MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE, -1, 0);
+    assertFatal(memory->pageFlags != MAP_FAILED, "<Memory> Unable to allocate page flags!");
+
+    memory->writtenPages = mmap(NULL, (FAST_MEMORY_SIZE >> PAGE_BITS) * sizeof(uint32_t), PROT_READ | PROT_WRITE,
+                                MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE, -1, 0);
+    assertFatal(memory->writtenPages != MAP_FAILED, "<Memory> Unable to allocate written pages!");
+
+    // Accesses which run into a guard region are turned into fatal errors.
+    pthread_once(&guardHandling, handleGuardFaults);
+
+    uint8_t *guard = memory->window + FAST_MEMORY_SIZE;
+    size_t slot = 0;
+    while (slot < MAX_FAST_MEMORIES) {
+        uint8_t *empty = NULL;
+        if (__atomic_compare_exchange_n(&guards[slot], &empty, guard, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            break;
+        }
+        slot++;
+    }
+
+    if (slot == MAX_FAST_MEMORIES) {
+        freeMem(memory);
+        throwFatal("<Memory> Too many fast memories!");
+    }
+
+    return memory;
+}
+
+/// Hashes a binary, as per 64-bit FNV-1a.
+/// @param bytes The binary.
+/// @param size The size of the binary in bytes.
+/// @returns The hash.
+static uint64_t hashBinary(const uint8_t *bytes, size_t size) {
+    uint64_t hash = BINARY_HASH_BASIS;
+    for (size_t i = 0; i < size; i++) hash = (hash ^ bytes[i]) * BINARY_HASH_PRIME;
+    return hash;
+}
+
+/// Installs [guardFault] as the handler of segmentation faults, for every thread.
+static void handleGuardFaults(void) {
+    // Not deferring the signal lets the handler jump straight out to [fatalBuffer].
+    struct sigaction action = { .sa_sigaction = guardFault, .sa_flags = SA_SIGINFO | SA_NODEFER };
+    sigemptyset(&action.sa_mask);
+    assertFatal(sigaction(SIGSEGV, &action, NULL) == 0, "<Memory> Unable to handle guard faults!");
+}
+
+/// Handles a segmentation fault, raising the fatal error of an out-of-bound access if it is within a guard region.
+/// @param signal The signal, i.e., SIGSEGV.
+/// @param info The details of the fault.
+/// @param context The interrupted context.
+/// @remark Guard faults are raised synchronously by [readMem] and [writeMem], so the error path is safe to take.
+static void guardFault(unused int signal, siginfo_t *info, unused void *context) {
+    uint8_t *fault = info->si_addr;
+    for (size_t i = 0; i < MAX_FAST_MEMORIES; i++) {
+        uint8_t *guard = __atomic_load_n(&guards[i], __ATOMIC_ACQUIRE);
+        if (guard != NULL && fault >= guard && fault < guard + GUARD_SIZE) {
+            throwFatal("<Memory> Received out-of-bound access to memory!");
+        }
+    }
+
+    // Any other fault is a genuine crash; returning with the default action re-raises it.
+    struct sigaction action = { .sa_handler = SIG_DFL };
+    sigaction(SIGSEGV, &action, NULL);
+}
+
+/// Finds the page containing [addr] in the page table.
+/// @param memory The address of the virtual memory.
+/// @param addr An address within the page.
+/// @param allocate Whether to allocate the page, zeroed, if it has not been already.
+/// @returns The page, or NULL if it has not been allocated and [allocate] is false.
+/// @pre [addr] is within [ADDRESS_SPACE].
+static Page *findPage(Memory memory, size_t addr, bool allocate) {
+    uint64_t pageNumber = addr >> PAGE_BITS;
+    if (memory->lastPage != NULL && memory->lastPageNumber == pageNumber) return memory->lastPage;
+
+    void **table = memory->pageTable;
+    for (size_t level = 0; level < TABLE_LEVELS; level++) {
+        void **entry = &table[(pageNumber >> ((TABLE_LEVELS - 1 - level) * TABLE_BITS)) % TABLE_ENTRIES];
+
+        if (*entry == NULL) {
+            if (!allocate) return NULL;
+
+            if (level < TABLE_LEVELS - 1) {
+                *entry = calloc(TABLE_ENTRIES, sizeof(void *));
+                assertFatalNotNull(*entry, "<Memory> Unable to allocate page table!");
+            } else {
+                Page *page = malloc(sizeof(Page));
+                assertFatalNotNull(page, "<Memory> Unable to allocate page!");
+
+                if (memory->window != NULL) {
+                    page->bytes = memory->window + (pageNumber << PAGE_BITS);
+                } else if ((pageNumber << PAGE_BITS) < memory->imageSize) {
+                    page->bytes = memory->image + (pageNumber << PAGE_BITS);
+                } else {
+                    page->bytes = calloc(MEMORY_PAGE_SIZE, sizeof(uint8_t));
+                    assertFatalNotNull(page->bytes, "<Memory> Unable to allocate page!");
+                }
+                page->decoded = NULL;
+                page->dirty = false;
+                *entry = page;
+            }
+        }
+
+        table = *entry;
+    }
+
+    memory->lastPage = (Page *) table;
+    memory->lastPageNumber = pageNumber;
+    return memory->lastPage;
+}
+
+/// Frees a table of the page table, and everything beneath it.
+/// @param memory The address of the virtual memory.
+/// @param table The table to free.
+/// @param level The level of [table], where the root is level 0.
+static void freeTable(Memory memory, void **table, size_t level) {
+    for (size_t i = 0; i < TABLE_ENTRIES; i++) {
+        if (table[i] == NULL) continue;
+
+        if (level < TABLE_LEVELS - 1) {
+            freeTable(memory, table[i], level + 1);
+        } else {
+            Page *page = table[i];
+            if (memory->window == NULL && !inImage(memory, page->bytes)) free(page->bytes);
+            free(page->decoded);
+            free(page);
+        }
+    }
+    free(table);
+}
+
+/// Resets a table of the page table, and everything beneath it, as per [resetMem].
+/// @param memory The address of the virtual memory.
+/// @param table The table to reset.
+/// @param level The level of [table], where the root is level 0.
+/// @returns Whether [table] is left empty, and has been freed.
+/// @remark Pages of fast memory only hold decoded instructions, so are always released.
+static bool resetTable(Memory memory, void **table, size_t level) {
+    bool empty = true;
+    for (size_t i = 0; i < TABLE_ENTRIES; i++) {
+        if (table[i] == NULL) continue;
+
+        if (level < TABLE_LEVELS - 1) {
+            if (resetTable(memory, table[i], level + 1)) table[i] = NULL;
+            else empty = false;
+            continue;
+        }
+
+        Page *page = table[i];
+        free(page->decoded);
+        page->decoded = NULL;
+        if (memory->window != NULL) memory->pageFlags[(page->bytes - memory->window) >> PAGE_BITS] &= ~PAGE_DECODED;
+
+        if (memory->window == NULL && inImage(memory, page->bytes)) {
+            if (page->dirty) {
+                // Drop the private copy, so the page is mapped from the file again.
+                size_t hostPage = sysconf(_SC_PAGESIZE);
+                size_t start = (page->bytes - memory->image) / hostPage * hostPage;
+                assertFatal(madvise(memory->image + start, hostPage, MADV_DONTNEED) == 0,
+                            "<Memory> Unable to reset memory!");
+                page->dirty = false;
+            }
+            empty = false;
+            continue;
+        }
+
+        if (memory->window == NULL) free(page->bytes);
+        free(page);
+        table[i] = NULL;
+    }
+
+    if (empty) free(table);
+    return empty;
+}
+
+/// Checks whether [bytes] lies within the mapping of the loaded binary of paged memory.
+/// @param memory The address of the virtual memory.
+/// @param bytes The contents of a page.
+/// @returns Whether [bytes] is part of [Memory_s.image].
+static bool inImage(Memory memory, const uint8_t *bytes) {
+    if (memory->image == NULL) return false;
+    return (uintptr_t) bytes >= (uintptr_t) memory->image
+           && (uintptr_t) bytes < (uintptr_t) memory->image + memory->imageSize;
+}
+
+/// Invalidates the cached decodings of every word overlapping [addr, addr + size).
+/// @param memory The address of the virtual memory.
+/// @param addr The first address written to.
+/// @param size The number of bytes written.
+static void invalidateDecoded(Memory memory, size_t addr, size_t size) {
+    for (size_t word = addr / WORD_SIZE; word <= (addr + size - 1) / WORD_SIZE; word++) {
+        Page *page = findPage(memory, word * WORD_SIZE, false);
+        if (page == NULL || page->decoded == NULL) continue;
+
+        DecodedSlot *slot = &page->decoded[word % PAGE_SLOTS];
+        if (!slot->valid) continue;
+
+        slot->valid = false;
+        memory->codeVersion++;
+    }
+}
+
+/// Marks the pages of fast memory overlapping [addr, addr + size) as written, invalidating any decoded words.
+/// @param memory The address of the virtual memory.
+/// @param addr The first address written to.
+/// @param size The number of bytes written.
+/// @remark Flags are shared by every view of the memory, so are only ever set atomically, and only when missing.
+static void markWritten(Memory memory, size_t addr, size_t size) {
+    // Pages written to are both dumped and reset.
+    uint8_t *first = &memory->pageFlags[addr >> PAGE_BITS];
+    uint8_t *last = &memory->pageFlags[(addr + size - 1) >> PAGE_BITS];
+    uint8_t firstFlags = __atomic_load_n(first, __ATOMIC_RELAXED);
+    uint8_t lastFlags = __atomic_load_n(last, __ATOMIC_RELAXED);
+    if ((firstFlags | lastFlags) & PAGE_DECODED) invalidateDecoded(memory, addr, size);
+
+    if (!(firstFlags & PAGE_WRITTEN)) recordWritten(memory, addr >> PAGE_BITS);
+    if (!(lastFlags & PAGE_WRITTEN) && last != first) recordWritten(memory, (addr + size - 1) >> PAGE_BITS);
+}
+
+/// Flags a page of fast memory as written, and adds it to [writtenPages] if it was not already.
+/// @param memory The address of the virtual memory.
+/// @param page The page number.
+/// @remark The list is shared by every view of the memory, so whichever thread flags the page adds it.
+static void recordWritten(Memory memory, size_t page) {
+    if (__atomic_fetch_or(&memory->pageFlags[page], PAGE_WRITTEN, __ATOMIC_RELAXED) & PAGE_WRITTEN) return;
+
+    Memory owner = memory->shared != NULL ? memory->shared : memory;
+    owner->writtenPages[__atomic_fetch_add(&owner->writtenCount, 1, __ATOMIC_RELAXED)] = page;
+}
+
+/// Frees the decoded-instruction caches of a table of the page table, and everything beneath it.
+/// @param table The table whose pages' caches to free.
+/// @param level The level of [table], where the root is level 0.
+static void discardTable(void **table, size_t level) {
+    for (size_t i = 0; i < TABLE_ENTRIES; i++) {
+        if (table[i] == NULL) continue;
+
+        if (level < TABLE_LEVELS - 1) {
+            discardTable(table[i], level + 1);
+        } else {
+            Page *page = table[i];
+            free(page->decoded);
+            page->decoded = NULL;
+        }
+    }
+}
+
+/// Reads 64/32-bits from virtual memory, as [readMem] does but unseen by any hook.
+/// @param memory The address of the virtual memory.
+/// @param as64 Whether to read 64 or 32 bits.
+/// @param addr The address within the virtual memory.
+/// @returns The 64-bit value at mem + addr.
+static BitData loadMem(Memory memory, bool as64, size_t addr) {
+    size_t readSize = as64 ? sizeof(uint64_t) : sizeof(uint32_t);
+
+    if (onBus(&memory->bus, addr)) {
+        Device *device = findDevice(&memory->bus, addr);
+        if (device != NULL) return readDevice(device, as64, addr);
+    }
+
+    if (memory->window != NULL) {
+        // A single host load; one running off the end of the window faults in the guard region.
+        if (addr >= FAST_MEMORY_SIZE) throwFatal("<Memory> Received out-of-bound read to memory!");
+
+        BitData result = 0;
+        memcpy(&result, memory->window + addr, readSize);
+        return result;
+    }
+
+    assertFatal(addr <= ADDRESS_SPACE - readSize, "<Memory> Received out-of-bound read to memory!");
+
+    // Read virtual memory as little-endian, from at most two pages.
+    const uint8_t *ptr = NULL;
+    uint64_t result = 0;
+    for (size_t i = 0; i < readSize; i++) {
+        if (i == 0 || (addr + i) % MEMORY_PAGE_SIZE == 0) {
+            Page *page = findPage(memory, addr + i, false);
+            ptr = page != NULL ? page->bytes : zeroPage;
+        }
+        result |= ((uint64_t) ptr[(addr + i) % MEMORY_PAGE_SIZE] << i * 8);
+    }
+    return result;
+}
+
+/// Checks whether [addr] is within a device's registers.
+/// @param memory The address of the virtual memory.
+/// @param addr The address within the virtual memory.
+/// @returns Whether [addr] is routed to a device.
+static bool isDevice(Memory memory, size_t addr) {
+    return onBus(&memory->bus, addr) && findDevice(&memory->bus, addr) != NULL;
+}
+
+/// Calls the write hooks attached to [memory] on a write, other than to a device, which is about to land.
+/// @param memory The address of the virtual memory, with hooks attached.
+/// @param as64 Whether the write is of 64 or 32 bits.
+/// @param addr The address within the virtual memory.
+/// @param old The value being overwritten.
+/// @param value The value being written.
+static void hookWrite(Memory memory, bool as64, size_t addr, BitData old, BitData value) {
+    fireMemoryHooks(memory, &(MemoryAccess) {
+        .write = true, .as64 = as64, .address = addr, .value = value, .old = old
+    });
 }
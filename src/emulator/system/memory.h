@@ -9,6 +9,8 @@
 #define EMULATOR_MEMORY_H
 
 #include <assert.h>
+#include <pthread.h>
+#include <signal.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -18,20 +20,192 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include "bus.h"
 #include "const.h"
 #include "error.h"
+#include "ir.h"
 
-/// Type definition representing virtual memory.
-typedef void *Memory;
+/// The number of bytes in one instruction word of virtual memory.
+#define WORD_SIZE        sizeof(Instruction)
 
-Memory allocMemFromFile(char *path);
+/// The number of bits of an address which give its offset within a page.
+#define PAGE_BITS        12
+
+/// The number of bytes in one page of virtual memory.
+#define MEMORY_PAGE_SIZE ((size_t) 1 << PAGE_BITS)
+
+/// The number of bits of a page number resolved by each level of the page table.
+#define TABLE_BITS       12
+
+/// The number of entries in each table of the page table.
+#define TABLE_ENTRIES    ((size_t) 1 << TABLE_BITS)
+
+/// The number of levels of the page table, which together resolve every page number of the address space.
+#define TABLE_LEVELS     ((ADDRESS_BITS - PAGE_BITS) / TABLE_BITS)
+
+/// The number of word-aligned slots in the decoded-instruction cache of one page.
+#define PAGE_SLOTS       (MEMORY_PAGE_SIZE / WORD_SIZE)
+
+/// The size of the address space of fast memory, all of which is reserved up front as one host window.
+#define FAST_MEMORY_SIZE ((uint64_t) 1 << 32)
+
+/// The number of bytes of inaccessible host memory following the window of fast memory.
+#define GUARD_SIZE       ((size_t) 1 << 16)
+
+/// The most fast memories which may exist at once.
+#define MAX_FAST_MEMORIES 16
+
+/// Flag of a page of fast memory which has been written to since it was loaded, or memory was last reset.
+#define PAGE_WRITTEN     0x1
+
+/// Flag of a page of fast memory with instructions in the decoded-instruction cache.
+#define PAGE_DECODED     0x2
+
+/// Flag of a page of fast memory which holds part of the loaded binary.
+#define PAGE_LOADED      0x4
+
+/// The hash of no bytes, from which [Memory_s.binaryHash] is taken, as per 64-bit FNV-1a.
+#define BINARY_HASH_BASIS 0xcbf29ce484222325
+
+/// The multiplier of each byte taken into [Memory_s.binaryHash], as per 64-bit FNV-1a.
+#define BINARY_HASH_PRIME 0x100000001b3
+
+/// The backends of virtual memory.
+typedef enum {
+    /// A sparse address space of [ADDRESS_SPACE] bytes, whose pages are allocated when first written to.
+    PAGED_MEMORY,
+
+    /// A window of [FAST_MEMORY_SIZE] bytes of host memory, accessed directly and bounded by a guard region.
+    FAST_MEMORY
+} MemoryMode;
+
+/// A decoded instruction, cached against the word-aligned address it was fetched from.
+typedef struct {
+    /// Whether [ir] is the decoding of the word currently stored at this address.
+    bool valid;
+
+    /// The decoded instruction.
+    IR ir;
+} DecodedSlot;
+
+/// Type definition representing a pointer to a cache of decoded basic blocks, see [blockCache.h].
+typedef struct BlockCache_s *BlockCache;
+
+/// Type definition representing a pointer to the code translated for the threaded interpreter, see [threaded.h].
+typedef struct ThreadedCode_s *ThreadedCode;
+
+/// Type definition representing a pointer to the hooks attached to a memory, see [hooks.h].
+typedef struct Hooks_s *Hooks;
+
+/// A page of virtual memory which has been written to.
+typedef struct {
+    /// The raw, little-endian contents of the page.
+    uint8_t *bytes;
+
+    /// Decoded-instruction cache, one slot per word of [bytes], or NULL if nothing on the page has been decoded.
+    /// @remark Slots are invalidated by [writeMem], so self-modifying code is re-decoded.
+    DecodedSlot *decoded;
+
+    /// Whether the page has been written to since it was loaded, or memory was last reset.
+    bool dirty;
+} Page;
+
+/// A struct representing, virtually, a machine's memory contents.
+/// @remark The address space is sparse: a page is only allocated once it is written to, and reads of any other
+/// page see zeroes. Fast memory leaves that to the host, whose pages of [window] are likewise only backed once
+/// written to.
+typedef struct Memory_s {
+    /// The size of the address space.
+    uint64_t size;
+
+    /// For fast memory, the host window holding the whole address space, followed by [GUARD_SIZE] bytes of
+    /// inaccessible memory; otherwise NULL.
+    uint8_t *window;
+
+    /// For fast memory, the [PAGE_WRITTEN], [PAGE_DECODED], and [PAGE_LOADED] flags of each page of [window].
+    uint8_t *pageFlags;
+
+    /// For fast memory, the page number of every page flagged [PAGE_WRITTEN], in the order they were first written.
+    uint32_t *writtenPages;
+
+    /// The number of [writtenPages].
+    size_t writtenCount;
+
+    /// For paged memory, the private (copy-on-write) mapping of the binary loaded at address 0, or NULL.
+    uint8_t *image;
+
+    /// The size of the mapping [image].
+    size_t imageSize;
+
+    /// The size in bytes of the binary loaded at address 0, or 0 if none was.
+    uint64_t binarySize;
+
+    /// A hash of the binary loaded at address 0, as it was loaded, so that what was loaded can be told apart.
+    uint64_t binaryHash;
+
+    /// The root of the page table; [TABLE_LEVELS] levels of [TABLE_ENTRIES] entries, each NULL or the next level,
+    /// with [Page]s at the leaves. For fast memory, only pages with decoded instructions are entered, pointing
+    /// into [window].
+    void **pageTable;
+
+    /// The most recently looked-up page, or NULL.
+    Page *lastPage;
+
+    /// The page number of [lastPage].
+    uint64_t lastPageNumber;
+
+    /// Incremented whenever a write lands on a word in [decoded], i.e., whenever decoded code goes stale.
+    uint64_t codeVersion;
+
+    /// Basic blocks decoded from this memory, or NULL if none have been recorded yet.
+    BlockCache blocks;
+
+    /// Code translated from this memory for the threaded interpreter, or NULL if it has not yet run over it.
+    ThreadedCode threaded;
+
+    /// The devices whose registers are mapped over this memory.
+    Bus bus;
+
+    /// For a view made by [createMemView], the memory whose contents it shares; otherwise NULL.
+    struct Memory_s *shared;
+
+    /// The hooks called on each access, and by [runHooked] on each instruction, or NULL if none are attached.
+    Hooks hooks;
+} Memory_s;
+
+/// Type definition representing a pointer to the memory struct.
+typedef Memory_s *Memory;
+
+Memory allocMemFromFile(char *path, MemoryMode mode);
 
 Memory allocMem(void);
 
+Memory createMemView(Memory shared);
+
 void freeMem(Memory mem);
 
+void resetMem(Memory mem);
+
 BitData readMem(Memory mem, bool as64, size_t addr);
 
+Instruction fetchMem(Memory mem, size_t addr);
+
+BitData peekMem(Memory mem, bool as64, size_t addr);
+
 void writeMem(Memory mem, bool as64, size_t addr, BitData value);
 
+bool exchangeMem(Memory mem, bool as64, size_t addr, BitData expected, BitData value);
+
+IR *getCachedIR(Memory mem, size_t addr);
+
+IR *cacheIR(Memory mem, size_t addr, IR ir);
+
+void discardDecoded(Memory mem);
+
+void writePage(Memory mem, size_t addr, const uint8_t *bytes);
+
+const uint8_t *nextPage(Memory mem, BitData *addr);
+
+const uint8_t *nextWrittenPage(Memory mem, BitData *addr);
+
 #endif // EMULATOR_MEMORY_H
@@ -7,6 +7,11 @@
 
 #include "output.h"
 
+/// The number of bytes of a page checked for zeroes at once when dumping memory.
+#define DUMP_CHUNK_SIZE 64
+
+static bool isZero(const uint8_t *bytes);
+
 void dumpRegs(Registers regs, FILE *fileOut) {
     fprintf(fileOut, "Registers:\n");
     for (int i = 0; i < NO_GPRS; i++) {
@@ -25,8 +30,34 @@ void dumpRegs(Registers regs, FILE *fileOut) {
 
 void dumpMem(Memory mem, FILE *fileOut) {
     fprintf(fileOut, "Non-Zero memory:\n");
-    for (int addr = 0; addr < MEMORY_SIZE; addr += 0x4) {
-        uint32_t curr = readMem(mem, false, addr);
-        if (curr) fprintf(fileOut, "0x%08x : %08x\n", addr, curr);
+
+    // Only pages which have been written to or loaded can hold anything non-zero.
+    BitData page = 0;
+    const uint8_t *bytes;
+    while ((bytes = nextPage(mem, &page)) != NULL) {
+        for (size_t chunk = 0; chunk < MEMORY_PAGE_SIZE; chunk += DUMP_CHUNK_SIZE) {
+            if (isZero(bytes + chunk)) continue;
+
+            for (size_t offset = chunk; offset < chunk + DUMP_CHUNK_SIZE; offset += 0x4) {
+                const uint8_t *word = bytes + offset;
+                uint32_t curr = word[0] | word[1] << 8 | word[2] << 16 | (uint32_t) word[3] << 24;
+                if (curr) fprintf(fileOut, "0x%08" PRIx64 " : %08x\n", page + offset, curr);
+            }
+        }
+        page += MEMORY_PAGE_SIZE;
+    }
+}
+
+/// Checks whether a chunk of memory is all zeroes.
+/// @param bytes The first of [DUMP_CHUNK_SIZE] bytes to check.
+/// @returns Whether every byte is zero.
+/// @remark The chunk is folded together a word at a time without branching, which compilers vectorise.
+static bool isZero(const uint8_t *bytes) {
+    uint64_t folded = 0;
+    for (size_t i = 0; i < DUMP_CHUNK_SIZE; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(uint64_t));
+        folded |= word;
     }
+    return folded == 0;
 }
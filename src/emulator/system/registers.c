@@ -19,6 +19,13 @@ static void initRegs(Registers registers) {
 
     // All flags are cleared on init except the zero-flag.
     registers->pstate = (PState) { false, true, false, false };
+    registers->flags.source = FLAGS_EVALUATED;
+
+    registers->instructions = 0;
+
+    registers->exclusive = false;
+    registers->exclusiveAddress = 0;
+    registers->exclusiveValue = 0;
 }
 
 /// Creates fresh registers, properly initialised at startup.
@@ -33,7 +40,7 @@ Registers_s createRegs(void) {
 /// @param registers Pointer to the registers.
 /// @param id The ID of the register to access.
 /// @return The value of the register, or 0 if [id] is out of range.
-BitData getReg(Registers registers, size_t id) {
+BitData getReg(const Registers_s *registers, size_t id) {
     if (id == ZERO_REGISTER) return 0; // Zero Register
     assertFatal(id < NO_GPRS, "Invalid register ID!");
     return registers->gprs[id];
@@ -42,36 +49,80 @@ BitData getReg(Registers registers, size_t id) {
 /// Gets the program counter.
 /// @param registers Pointer to the registers.
 /// @return The value of the program counter.
-BitData getRegPC(Registers registers) {
+BitData getRegPC(const Registers_s *registers) {
     return registers->pc;
 }
 
 /// Gets the stack pointer as a 64-bit value.
 /// @param registers Pointer to the registers.
 /// @return The value of the stack pointer.
-BitData getRegSP(Registers registers) {
+BitData getRegSP(const Registers_s *registers) {
     return registers->sp;
 }
 
-/// Gets the requested PState flag.
+/// Gets the requested PState flag, evaluating only that flag if the flags are pending.
 /// @param registers Pointer to the registers.
 /// @param field The field required.
 /// @return The value of the PState flag [field].
-bool getRegState(Registers registers, PStateField field) {
+bool getRegState(const Registers_s *registers, PStateField field) {
+    const LazyFlags *flags = &registers->flags;
+    if (flags->source == FLAGS_EVALUATED) {
+        switch (field) {
+            case N:
+                return registers->pstate.ng;
+            case Z:
+                return registers->pstate.zr;
+            case C:
+                return registers->pstate.cr;
+            case V:
+                return registers->pstate.ov;
+            default:
+                throwFatal("Invalid PState field!");
+        }
+    }
+
+    bool sf = flags->sf;
+    uint64_t rn = flags->rn, op2 = flags->op2, res = flags->res;
     switch (field) {
         case N:
-            return registers->pstate.ng;
+            return sf ? res > INT64_MAX : (uint32_t) res > INT32_MAX;
         case Z:
-            return registers->pstate.zr;
+            return sf ? res == 0 : (uint32_t) res == 0;
         case C:
-            return registers->pstate.cr;
+            if (flags->source == FLAGS_ADD) return sf ? op2 > UINT64_MAX - rn : op2 > UINT32_MAX - rn;
+            if (flags->source == FLAGS_SUB) return op2 <= rn;
+            return false;
         case V:
-            return registers->pstate.ov;
+            if (flags->source == FLAGS_ADD) return sf ? overflow64(rn, op2, res) : overflow32(rn, op2, res);
+            if (flags->source == FLAGS_SUB) return sf ? underflow64(rn, op2, res) : underflow32(rn, op2, res);
+            return false;
         default:
             throwFatal("Invalid PState field!");
     }
 }
 
+/// Gets all PState flags, evaluating them if they are pending.
+/// @param registers Pointer to the registers.
+/// @return The PState flags.
+PState getRegStates(const Registers_s *registers) {
+    if (registers->flags.source == FLAGS_EVALUATED) return registers->pstate;
+
+    return (PState) {
+        .ng = getRegState(registers, N),
+        .zr = getRegState(registers, Z),
+        .cr = getRegState(registers, C),
+        .ov = getRegState(registers, V),
+    };
+}
+
+/// Gets all PState flags packed, as the condition codes are evaluated over.
+/// @param registers Pointer to the registers.
+/// @return The flags, as \code N << 3 | Z << 2 | C << 1 | V \endcode.
+uint8_t getRegNZCV(const Registers_s *registers) {
+    PState state = getRegStates(registers);
+    return state.ng << 3 | state.zr << 2 | state.cr << 1 | state.ov;
+}
+
 /// Sets the value of a register; choice between 32 or 64-bit.
 /// @param registers Pointer to the registers.
 /// @param id The ID of the register to access.
@@ -109,6 +160,7 @@ void setRegSP(Registers registers, bool as64, BitData value) {
 /// @param field The field required.
 /// @param state The value to write.
 void setRegState(Registers registers, PStateField field, bool state) {
+    evaluateRegStates(registers);
     switch (field) {
         case N:
             registers->pstate.ng = state;
@@ -132,4 +184,25 @@ void setRegState(Registers registers, PStateField field, bool state) {
 /// @param state The states to write.
 void setRegStates(Registers registers, PState state) {
     registers->pstate = state;
+    registers->flags.source = FLAGS_EVALUATED;
+}
+
+/// Records the last flag-setting operation, from which the PState flags are evaluated when next read.
+/// @param registers Pointer to the registers.
+/// @param source The kind of operation.
+/// @param sf Whether the operation was 64-bit.
+/// @param rn The first operand, at the width of the operation.
+/// @param op2 The second operand, at the width of the operation.
+/// @param res The result of the operation.
+/// @remark Most flag-setting results are overwritten before any condition reads them, so deferring their
+/// evaluation saves the overflow and carry checks entirely.
+void setRegFlags(Registers registers, FlagSource source, bool sf, uint64_t rn, uint64_t op2, uint64_t res) {
+    registers->flags = (LazyFlags) { .source = source, .sf = sf, .rn = rn, .op2 = op2, .res = res };
+}
+
+/// Evaluates any pending PState flags into [Registers_s.pstate].
+/// @param registers Pointer to the registers.
+void evaluateRegStates(Registers registers) {
+    if (registers->flags.source == FLAGS_EVALUATED) return;
+    setRegStates(registers, getRegStates(registers));
 }
@@ -12,6 +12,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "conditions.h"
 #include "const.h"
 #include "error.h"
 
@@ -45,8 +46,41 @@ typedef enum {
     V
 } PStateField;
 
-/// A struct representing, virtually, a machine's register contents.
+/// An enum representing the kind of operation which last set the PSTATE flags.
+typedef enum {
+    /// The flags are held, already evaluated, in [Registers_s.pstate].
+    FLAGS_EVALUATED,
+
+    /// The flags are those of an addition.
+    FLAGS_ADD,
+
+    /// The flags are those of a subtraction.
+    FLAGS_SUB,
+
+    /// The flags are those of a logical operation, i.e., C and V are clear.
+    FLAGS_LOGIC
+} FlagSource;
+
+/// A struct representing the last flag-setting operation, from which PSTATE is evaluated only when read.
 typedef struct {
+    /// The kind of operation, or [FLAGS_EVALUATED] if there is none to evaluate.
+    FlagSource source;
+
+    /// Whether the operation was 64-bit.
+    bool sf;
+
+    /// The first operand, at the width of the operation.
+    uint64_t rn;
+
+    /// The second operand, at the width of the operation.
+    uint64_t op2;
+
+    /// The result of the operation.
+    uint64_t res;
+} LazyFlags;
+
+/// A struct representing, virtually, a machine's register contents.
+typedef struct Registers_s {
     /// General purpose registers.
     BitData gprs[NO_GPRS];
 
@@ -60,8 +94,23 @@ typedef struct {
     /// Stack pointer.
     BitData sp;
 
-    /// Program state register. Contains boolean flags.
+    /// Program state register. Contains boolean flags; only current if [flags] is [FLAGS_EVALUATED].
     PState pstate;
+
+    /// The last flag-setting operation, not yet evaluated into [pstate].
+    LazyFlags flags;
+
+    /// The number of instructions executed so far, including those skipped over by [skipIdleLoop].
+    uint64_t instructions;
+
+    /// Whether the exclusive monitor is armed, i.e., a load exclusive has not yet been followed by its store.
+    bool exclusive;
+
+    /// The address the exclusive monitor is armed on.
+    BitData exclusiveAddress;
+
+    /// The value loaded by the load exclusive which armed the monitor.
+    BitData exclusiveValue;
 } Registers_s;
 
 /// Type definition representing a pointer to the registers struct.
@@ -69,13 +118,17 @@ typedef Registers_s *Registers;
 
 Registers_s createRegs(void);
 
-BitData getReg(Registers regs, size_t id);
+BitData getReg(const Registers_s *regs, size_t id);
+
+BitData getRegPC(const Registers_s *regs);
+
+BitData getRegSP(const Registers_s *regs);
 
-BitData getRegPC(Registers regs);
+bool getRegState(const Registers_s *regs, PStateField field);
 
-BitData getRegSP(Registers regs);
+PState getRegStates(const Registers_s *regs);
 
-bool getRegState(Registers regs, PStateField field);
+uint8_t getRegNZCV(const Registers_s *regs);
 
 void setReg(Registers regs, size_t id, bool as64, BitData value);
 
@@ -89,4 +142,8 @@ void setRegState(Registers regs, PStateField field, bool state);
 
 void setRegStates(Registers regs, PState state);
 
+void setRegFlags(Registers regs, FlagSource source, bool sf, uint64_t rn, uint64_t op2, uint64_t res);
+
+void evaluateRegStates(Registers regs);
+
 #endif // EMULATOR_REGISTER_H
@@ -0,0 +1,617 @@
+///
+/// threaded.c
+/// A direct-threaded interpreter, dispatching on flat per-instruction handlers with computed goto.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "threaded.h"
+#include "emulatorDelegate.h"
+
+/// The number of [ThreadedOp]s: one per word of virtual memory, and a sentinel for running off its end.
+#define THREADED_OPS (LOW_MEMORY_SIZE / WORD_SIZE + 1)
+
+static void translateOp(ThreadedOp *op, Memory memory, BitData address);
+
+static void fuseBranch(ThreadedOp *op, Memory memory, BitData address);
+
+/// Creates the code of a memory, with every op untranslated.
+/// @returns The new [ThreadedCode].
+ThreadedCode createThreadedCode(void) {
+    ThreadedCode code = malloc(sizeof(struct ThreadedCode_s));
+    assertFatalNotNull(code, "<Memory> Unable to allocate [ThreadedCode]!");
+
+    code->ops = mmap(NULL, THREADED_OPS * sizeof(ThreadedOp), PROT_READ | PROT_WRITE,
+                     MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    assertFatal(code->ops != MAP_FAILED, "<Memory> Unable to allocate threaded code!");
+
+    code->codeVersion = 0;
+    flushThreadedCode(code);
+    return code;
+}
+
+/// Frees the given code.
+/// @param code The code to free.
+void destroyThreadedCode(ThreadedCode code) {
+    assertFatal(munmap(code->ops, THREADED_OPS * sizeof(ThreadedOp)) == 0, "<Memory> Unable to un-map threaded code!");
+    free(code);
+}
+
+/// Discards every translated op, so that each is translated again when next reached.
+/// @param code The code to flush.
+/// @remark The ops are handed back to the host, which maps zeroes, i.e., [HANDLE_TRANSLATE], in their place. So a
+/// flush costs in proportion to the pages of ops touched, not the size of memory.
+void flushThreadedCode(ThreadedCode code) {
+    assertFatal(madvise(code->ops, THREADED_OPS * sizeof(ThreadedOp), MADV_DONTNEED) == 0,
+                "<Memory> Unable to flush threaded code!");
+
+    // Running off the end of memory is left to [execute] to report.
+    code->ops[THREADED_OPS - 1].handler = HANDLE_STEP;
+}
+
+/// Reads register [id], as in [getReg], but truncated to 32 bits unless [sf].
+static inline BitData readX(Registers registers, uint8_t id, bool sf) {
+    if (id == ZERO_REGISTER) return 0;
+    return sf ? registers->gprs[id] : (uint32_t) registers->gprs[id];
+}
+
+/// Writes [value] to register [id], as in [setReg].
+static inline void writeX(Registers registers, uint8_t id, bool sf, BitData value) {
+    if (id != ZERO_REGISTER) registers->gprs[id] = sf ? value : (uint32_t) value;
+}
+
+/// Performs an arithmetic operation, following [arithmeticExecute].
+/// @remark Always inlined with constant [sf], [subtract] and [setFlags], so each handler gets its own
+/// branch-free copy.
+static inline void arithmetic(Registers registers, ThreadedOp *op, BitData rn, BitData op2,
+                              bool sf, bool subtract, bool setFlags) {
+    BitData res = subtract ? rn - op2 : rn + op2;
+
+    if (setFlags) {
+        registers->flags = (LazyFlags) {
+            .source = subtract ? FLAGS_SUB : FLAGS_ADD, .sf = sf, .rn = rn, .op2 = op2, .res = res
+        };
+    }
+
+    writeX(registers, op->rd, sf, res);
+}
+
+/// Gets the shifted second operand of a data processing (register) instruction, following [bitShift].
+/// @pre For 32-bit operations, [ThreadedOp.amount] is less than 32.
+static inline BitData shiftedOperand(Registers registers, ThreadedOp *op, bool sf) {
+    BitData rm = readX(registers, op->rm, sf);
+    uint8_t amount = op->amount;
+    BitData shifted;
+
+    switch (op->shift) {
+        case LSL:
+            shifted = rm << amount;
+            break;
+
+        case LSR:
+            shifted = rm >> amount;
+            break;
+
+        case ASR:
+            shifted = sf ? (BitData) ((int64_t) rm >> amount) : (BitData) ((int32_t) rm >> amount);
+            break;
+
+        case ROR:
+            shifted = amount == 0 ? rm : (rm >> amount) | (rm << ((sf ? 64 : 32) - amount));
+            break;
+
+        default:
+            shifted = rm;
+            break;
+    }
+
+    return (sf ? shifted : (uint32_t) shifted) ^ op->invert;
+}
+
+/// Performs a bit-logic operation, following [bitLogicExecute].
+static inline void bitLogic(Registers registers, ThreadedOp *op, enum StandardType type, bool sf) {
+    BitData rn = readX(registers, op->rn, sf);
+    BitData op2 = shiftedOperand(registers, op, sf);
+    BitData res;
+
+    switch (type) {
+        case ORR:
+            res = rn | op2;
+            break;
+
+        case EOR:
+            res = rn ^ op2;
+            break;
+
+        default:
+            res = rn & op2;
+            break;
+    }
+
+    if (type == ANDS) {
+        registers->flags = (LazyFlags) { .source = FLAGS_LOGIC, .sf = sf, .rn = rn, .op2 = op2, .res = res };
+    }
+
+    writeX(registers, op->rd, sf, res);
+}
+
+/// Performs a subtraction fused with the conditional branch after it, following [executeCompareBranch].
+/// @returns Whether the branch is taken.
+static inline bool compareBranch(Registers registers, ThreadedOp *op, BitData rn, BitData op2, bool sf) {
+    BitData res = rn - op2;
+    registers->flags = (LazyFlags) { .source = FLAGS_SUB, .sf = sf, .rn = rn, .op2 = op2, .res = res };
+    writeX(registers, op->rd, sf, res);
+    return op->truth >> subtractionNZCV(sf, rn, op2, res) & 1;
+}
+
+/// Performs a multiply-add or multiply-subtract, following [multiplyExecute].
+static inline void multiply(Registers registers, ThreadedOp *op, bool subtract, bool sf) {
+    BitData ra = readX(registers, op->ra, sf);
+    BitData product = readX(registers, op->rn, sf) * readX(registers, op->rm, sf);
+    writeX(registers, op->rd, sf, subtract ? ra - product : ra + product);
+}
+
+// Computed goto is a GNU extension, which [--pedantic-errors] would otherwise reject.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+/// Runs the program from the current PC until it reaches a halt, or [Registers_s.instructions] reaches [limit],
+/// dispatching each instruction straight to its handler.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @param limit The instruction count to stop at.
+/// @returns Whether the program halted, rather than running into [limit].
+/// @remark Each instruction is translated to a [ThreadedOp] the first time it is reached, and every handler
+/// ends in its own indirect jump to the next, so the host's branch predictor sees one site per handler rather
+/// than a single shared dispatch. Translations are kept on [memory], so a run cut short by [limit] resumes on them.
+bool runThreaded(Registers registers, Memory memory, uint64_t limit) {
+    static const void *handlers[HANDLE_COUNT] = {
+        [HANDLE_TRANSLATE] = &&translate,
+        [HANDLE_STEP] = &&step,
+        [HANDLE_HALT] = &&halt,
+        [HANDLE_EXECUTE] = &&executor,
+        [HANDLE_LOAD_STORE] = &&loadStore,
+
+        [HANDLE_ADD_IMMEDIATE_64] = &&addImmediate64,
+        [HANDLE_ADD_IMMEDIATE_32] = &&addImmediate32,
+        [HANDLE_ADDS_IMMEDIATE_64] = &&addsImmediate64,
+        [HANDLE_ADDS_IMMEDIATE_32] = &&addsImmediate32,
+        [HANDLE_SUB_IMMEDIATE_64] = &&subImmediate64,
+        [HANDLE_SUB_IMMEDIATE_32] = &&subImmediate32,
+        [HANDLE_SUBS_IMMEDIATE_64] = &&subsImmediate64,
+        [HANDLE_SUBS_IMMEDIATE_32] = &&subsImmediate32,
+        [HANDLE_MOVE_WIDE] = &&moveWide,
+        [HANDLE_MOVK_64] = &&movk64,
+        [HANDLE_MOVK_32] = &&movk32,
+
+        [HANDLE_ADD_REGISTER_64] = &&addRegister64,
+        [HANDLE_ADD_REGISTER_32] = &&addRegister32,
+        [HANDLE_ADDS_REGISTER_64] = &&addsRegister64,
+        [HANDLE_ADDS_REGISTER_32] = &&addsRegister32,
+        [HANDLE_SUB_REGISTER_64] = &&subRegister64,
+        [HANDLE_SUB_REGISTER_32] = &&subRegister32,
+        [HANDLE_SUBS_REGISTER_64] = &&subsRegister64,
+        [HANDLE_SUBS_REGISTER_32] = &&subsRegister32,
+        [HANDLE_AND_64] = &&and64,
+        [HANDLE_AND_32] = &&and32,
+        [HANDLE_ORR_64] = &&orr64,
+        [HANDLE_ORR_32] = &&orr32,
+        [HANDLE_EOR_64] = &&eor64,
+        [HANDLE_EOR_32] = &&eor32,
+        [HANDLE_ANDS_64] = &&ands64,
+        [HANDLE_ANDS_32] = &&ands32,
+        [HANDLE_MADD_64] = &&madd64,
+        [HANDLE_MADD_32] = &&madd32,
+        [HANDLE_MSUB_64] = &&msub64,
+        [HANDLE_MSUB_32] = &&msub32,
+
+        [HANDLE_B] = &&b,
+        [HANDLE_B_COND] = &&bCond,
+        [HANDLE_BR] = &&br,
+
+        [HANDLE_SUBS_IMMEDIATE_B_COND_64] = &&subsImmediateBCond64,
+        [HANDLE_SUBS_IMMEDIATE_B_COND_32] = &&subsImmediateBCond32,
+        [HANDLE_SUBS_REGISTER_B_COND_64] = &&subsRegisterBCond64,
+        [HANDLE_SUBS_REGISTER_B_COND_32] = &&subsRegisterBCond32,
+    };
+
+    if (memory->threaded == NULL) memory->threaded = createThreadedCode();
+    ThreadedCode code = memory->threaded;
+    ThreadedOp *ops = code->ops;
+    ThreadedOp *op;
+    bool halted = true;
+
+// The address of the current instruction, which is implied by its [ThreadedOp]'s position.
+#define PC ((BitData) (op - ops) * WORD_SIZE)
+
+// Dispatches to the handler of [op].
+#define DISPATCH() goto *handlers[op->handler]
+
+// Dispatches to the handler of [op], unless the budget has run out, in which case [step] stops there.
+#define CONTINUE() do { if (registers->instructions >= limit) goto step; DISPATCH(); } while (0)
+
+// Counts the current instruction, then moves on to, and dispatches, the next instruction.
+#define NEXT() do { registers->instructions++; op++; CONTINUE(); } while (0)
+
+// Counts the current instruction, then moves on to, and dispatches, the instruction in [__SLOT__].
+#define JUMP(__SLOT__) do { registers->instructions++; op = ops + (__SLOT__); CONTINUE(); } while (0)
+
+// Counts the current fused pair, then moves on to, and dispatches, its branch target if [__TAKEN__], or else the
+// instruction after the pair. If only the compare fits in the budget, it is stepped alone.
+#define FUSED(__TAKEN__) \
+    do { \
+        if (limit - registers->instructions < 2) goto step; \
+        registers->instructions += 2; \
+        op = (__TAKEN__) ? ops + op->target : op + 2; \
+        CONTINUE(); \
+    } while (0)
+
+resume:
+    // A write has landed on decoded code, here or since the last run, so every translation may be stale.
+    if (code->codeVersion != memory->codeVersion) {
+        flushThreadedCode(code);
+        code->codeVersion = memory->codeVersion;
+    }
+
+    // Continue from the PC in [registers], which only [step] handles if it is unaligned or out of bounds.
+    if (registers->pc % WORD_SIZE != 0 || registers->pc >= LOW_MEMORY_SIZE) goto stepPC;
+    op = ops + registers->pc / WORD_SIZE;
+    CONTINUE();
+
+translate:
+    translateOp(op, memory, PC);
+    DISPATCH();
+
+step:
+    registers->pc = PC;
+
+stepPC: {
+        // Leave anything the threaded core cannot address to [execute], exactly as the reference engine would.
+        Instruction instruction = readMem(memory, false, registers->pc);
+        if (instruction == HALT) goto done;
+        if (registers->instructions >= limit) goto exhausted;
+        execute(&instruction, registers, memory);
+        goto resume;
+    }
+
+halt:
+    registers->pc = PC;
+    goto done;
+
+executor:
+    registers->pc = PC;
+    op->execute(op->ir, registers, memory);
+    registers->instructions++;
+    if (registers->pc == PC) registers->pc += WORD_SIZE;
+    goto resume;
+
+loadStore:
+    registers->pc = PC;
+    executeLoadStore(op->ir, registers, memory);
+    if (memory->codeVersion == code->codeVersion) NEXT();
+    registers->instructions++;
+    registers->pc = PC + WORD_SIZE;
+    goto resume;
+
+addImmediate64:
+    arithmetic(registers, op, readX(registers, op->rn, true), op->imm, true, false, false);
+    NEXT();
+addImmediate32:
+    arithmetic(registers, op, readX(registers, op->rn, false), op->imm, false, false, false);
+    NEXT();
+addsImmediate64:
+    arithmetic(registers, op, readX(registers, op->rn, true), op->imm, true, false, true);
+    NEXT();
+addsImmediate32:
+    arithmetic(registers, op, readX(registers, op->rn, false), op->imm, false, false, true);
+    NEXT();
+subImmediate64:
+    arithmetic(registers, op, readX(registers, op->rn, true), op->imm, true, true, false);
+    NEXT();
+subImmediate32:
+    arithmetic(registers, op, readX(registers, op->rn, false), op->imm, false, true, false);
+    NEXT();
+subsImmediate64:
+    arithmetic(registers, op, readX(registers, op->rn, true), op->imm, true, true, true);
+    NEXT();
+subsImmediate32:
+    arithmetic(registers, op, readX(registers, op->rn, false), op->imm, false, true, true);
+    NEXT();
+
+moveWide:
+    writeX(registers, op->rd, true, op->imm);
+    NEXT();
+movk64:
+    writeX(registers, op->rd, true,
+           op->imm | (readX(registers, op->rd, true) & ~((BitData) UINT16_MAX << op->amount)));
+    NEXT();
+movk32:
+    writeX(registers, op->rd, false,
+           op->imm | (readX(registers, op->rd, false) & ~((BitData) UINT16_MAX << op->amount)));
+    NEXT();
+
+addRegister64:
+    arithmetic(registers, op, readX(registers, op->rn, true), shiftedOperand(registers, op, true),
+               true, false, false);
+    NEXT();
+addRegister32:
+    arithmetic(registers, op, readX(registers, op->rn, false), shiftedOperand(registers, op, false),
+               false, false, false);
+    NEXT();
+addsRegister64:
+    arithmetic(registers, op, readX(registers, op->rn, true), shiftedOperand(registers, op, true),
+               true, false, true);
+    NEXT();
+addsRegister32:
+    arithmetic(registers, op, readX(registers, op->rn, false), shiftedOperand(registers, op, false),
+               false, false, true);
+    NEXT();
+subRegister64:
+    arithmetic(registers, op, readX(registers, op->rn, true), shiftedOperand(registers, op, true),
+               true, true, false);
+    NEXT();
+subRegister32:
+    arithmetic(registers, op, readX(registers, op->rn, false), shiftedOperand(registers, op, false),
+               false, true, false);
+    NEXT();
+subsRegister64:
+    arithmetic(registers, op, readX(registers, op->rn, true), shiftedOperand(registers, op, true),
+               true, true, true);
+    NEXT();
+subsRegister32:
+    arithmetic(registers, op, readX(registers, op->rn, false), shiftedOperand(registers, op, false),
+               false, true, true);
+    NEXT();
+
+and64:
+    bitLogic(registers, op, AND, true);
+    NEXT();
+and32:
+    bitLogic(registers, op, AND, false);
+    NEXT();
+orr64:
+    bitLogic(registers, op, ORR, true);
+    NEXT();
+orr32:
+    bitLogic(registers, op, ORR, false);
+    NEXT();
+eor64:
+    bitLogic(registers, op, EOR, true);
+    NEXT();
+eor32:
+    bitLogic(registers, op, EOR, false);
+    NEXT();
+ands64:
+    bitLogic(registers, op, ANDS, true);
+    NEXT();
+ands32:
+    bitLogic(registers, op, ANDS, false);
+    NEXT();
+
+madd64:
+    multiply(registers, op, false, true);
+    NEXT();
+madd32:
+    multiply(registers, op, false, false);
+    NEXT();
+msub64:
+    multiply(registers, op, true, true);
+    NEXT();
+msub32:
+    multiply(registers, op, true, false);
+    NEXT();
+
+b:
+    JUMP(op->imm);
+bCond:
+    if (op->truth >> getRegNZCV(registers) & 1) JUMP(op->imm);
+    NEXT();
+
+br: {
+        // As in [execute], a branch which leaves the PC where it was is treated as not having branched.
+        BitData target = readX(registers, op->rn, true);
+        registers->pc = target == PC ? PC + WORD_SIZE : target;
+        registers->instructions++;
+        goto resume;
+    }
+
+subsImmediateBCond64:
+    FUSED(compareBranch(registers, op, readX(registers, op->rn, true), op->imm, true));
+subsImmediateBCond32:
+    FUSED(compareBranch(registers, op, readX(registers, op->rn, false), op->imm, false));
+subsRegisterBCond64:
+    FUSED(compareBranch(registers, op, readX(registers, op->rn, true), shiftedOperand(registers, op, true), true));
+subsRegisterBCond32:
+    FUSED(compareBranch(registers, op, readX(registers, op->rn, false), shiftedOperand(registers, op, false), false));
+
+exhausted:
+    halted = false;
+
+done:
+    return halted;
+
+#undef PC
+#undef DISPATCH
+#undef CONTINUE
+#undef NEXT
+#undef JUMP
+#undef FUSED
+}
+
+#pragma GCC diagnostic pop
+
+/// Translates the instruction at [address] into [op].
+/// @param op The [ThreadedOp] to translate into.
+/// @param memory The address of the virtual memory.
+/// @param address The address of the instruction.
+static void translateOp(ThreadedOp *op, Memory memory, BitData address) {
+    Instruction instruction = readMem(memory, false, address);
+
+    // Even a halt is decoded, so that overwriting it invalidates this translation.
+    IR *ir = getCachedIR(memory, address);
+    if (ir == NULL) ir = cacheIR(memory, address, getDecodeFunction(instruction)(instruction));
+
+    *op = (ThreadedOp) { .handler = HANDLE_EXECUTE, .ir = ir, .execute = getExecuteFunction(ir) };
+    if (instruction == HALT) {
+        op->handler = HANDLE_HALT;
+        return;
+    }
+
+    switch (ir->type) {
+        case IMMEDIATE: {
+            Immediate_IR *immediateIR = &ir->ir.immediateIR;
+            bool sf = immediateIR->sf;
+            op->rd = immediateIR->rd;
+
+            if (immediateIR->opi == IMMEDIATE_ARITHMETIC) {
+                struct Arithmetic *operand = &immediateIR->operand.arithmetic;
+                static const Handler arithmetic[][2] = {
+                    [ADD] = { HANDLE_ADD_IMMEDIATE_32, HANDLE_ADD_IMMEDIATE_64 },
+                    [ADDS] = { HANDLE_ADDS_IMMEDIATE_32, HANDLE_ADDS_IMMEDIATE_64 },
+                    [SUB] = { HANDLE_SUB_IMMEDIATE_32, HANDLE_SUB_IMMEDIATE_64 },
+                    [SUBS] = { HANDLE_SUBS_IMMEDIATE_32, HANDLE_SUBS_IMMEDIATE_64 },
+                };
+                op->handler = arithmetic[immediateIR->opc.arithmeticType][sf];
+                op->rn = operand->rn;
+                op->imm = (uint32_t) operand->imm12 << (operand->sh * 12);
+                break;
+            }
+
+            struct WideMove *operand = &immediateIR->operand.wideMove;
+            BitData value = (BitData) operand->imm16 << (operand->hw * 16);
+            switch (immediateIR->opc.wideMoveType) {
+                case MOVN:
+                    op->handler = HANDLE_MOVE_WIDE;
+                    op->imm = sf ? ~value : (uint32_t) ~value;
+                    break;
+
+                case MOVZ:
+                    op->handler = HANDLE_MOVE_WIDE;
+                    op->imm = value;
+                    break;
+
+                case MOVK:
+                    op->handler = sf ? HANDLE_MOVK_64 : HANDLE_MOVK_32;
+                    op->imm = value;
+                    op->amount = operand->hw * 16;
+                    break;
+            }
+            break;
+        }
+
+        case REGISTER: {
+            Register_IR *registerIR = &ir->ir.registerIR;
+            bool sf = registerIR->sf;
+
+            // Reserved 32-bit shift amounts are left to the executor, whatever it makes of them.
+            if (registerIR->group != MULTIPLY && !sf && registerIR->operand.imm6 >= 32) break;
+
+            op->rd = registerIR->rd;
+            op->rn = registerIR->rn;
+            op->rm = registerIR->rm;
+
+            switch (registerIR->group) {
+                case ARITHMETIC: {
+                    static const Handler arithmetic[][2] = {
+                        [ADD] = { HANDLE_ADD_REGISTER_32, HANDLE_ADD_REGISTER_64 },
+                        [ADDS] = { HANDLE_ADDS_REGISTER_32, HANDLE_ADDS_REGISTER_64 },
+                        [SUB] = { HANDLE_SUB_REGISTER_32, HANDLE_SUB_REGISTER_64 },
+                        [SUBS] = { HANDLE_SUBS_REGISTER_32, HANDLE_SUBS_REGISTER_64 },
+                    };
+                    op->handler = arithmetic[registerIR->opc.arithmetic][sf];
+                    op->shift = registerIR->shift;
+                    op->amount = registerIR->operand.imm6;
+                    break;
+                }
+
+                case BIT_LOGIC: {
+                    // Standard and negated bit-logic opcodes share ordinals.
+                    static const Handler logic[][2] = {
+                        [AND] = { HANDLE_AND_32, HANDLE_AND_64 },
+                        [ORR] = { HANDLE_ORR_32, HANDLE_ORR_64 },
+                        [EOR] = { HANDLE_EOR_32, HANDLE_EOR_64 },
+                        [ANDS] = { HANDLE_ANDS_32, HANDLE_ANDS_64 },
+                    };
+                    op->handler = logic[registerIR->opc.logic.standard][sf];
+                    op->shift = registerIR->shift;
+                    op->amount = registerIR->operand.imm6;
+                    op->invert = registerIR->negated ? (sf ? UINT64_MAX : UINT32_MAX) : 0;
+                    break;
+                }
+
+                case MULTIPLY:
+                    op->handler = registerIR->operand.multiply.x
+                                  ? (sf ? HANDLE_MSUB_64 : HANDLE_MSUB_32)
+                                  : (sf ? HANDLE_MADD_64 : HANDLE_MADD_32);
+                    op->ra = registerIR->operand.multiply.ra;
+                    break;
+            }
+            break;
+        }
+
+        case LOAD_STORE:
+            op->handler = HANDLE_LOAD_STORE;
+            break;
+
+        case BRANCH: {
+            Branch_IR *branchIR = &ir->ir.branchIR;
+            if (branchIR->type == BRANCH_REGISTER) {
+                op->handler = HANDLE_BR;
+                op->rn = branchIR->data.xn;
+                break;
+            }
+
+            int64_t offset = branchIR->type == BRANCH_UNCONDITIONAL
+                             ? branchIR->data.simm26.data.immediate
+                             : branchIR->data.conditional.simm19.data.immediate;
+
+            // As in [execute], a branch to itself falls through; targets out of bounds are left to the executor.
+            BitData target = offset == 0 ? address + WORD_SIZE : address + 4 * offset;
+            if (target >= LOW_MEMORY_SIZE) break;
+            op->imm = target / WORD_SIZE;
+
+            if (branchIR->type == BRANCH_UNCONDITIONAL) {
+                op->handler = HANDLE_B;
+                break;
+            }
+
+            op->truth = conditionTruthTable(branchIR->data.conditional.condition);
+            op->handler = op->truth == UINT16_MAX ? HANDLE_B : HANDLE_B_COND;
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    fuseBranch(op, memory, address);
+}
+
+/// Fuses the compare translated into [op] with the conditional branch after it, if there is one.
+/// @param op The [ThreadedOp] just translated.
+/// @param memory The address of the virtual memory.
+/// @param address The address of the instruction of [op].
+/// @remark The branch keeps its own op too, for anything jumping straight to it.
+static void fuseBranch(ThreadedOp *op, Memory memory, BitData address) {
+    static const Handler fused[HANDLE_COUNT] = {
+        [HANDLE_SUBS_IMMEDIATE_64] = HANDLE_SUBS_IMMEDIATE_B_COND_64,
+        [HANDLE_SUBS_IMMEDIATE_32] = HANDLE_SUBS_IMMEDIATE_B_COND_32,
+        [HANDLE_SUBS_REGISTER_64] = HANDLE_SUBS_REGISTER_B_COND_64,
+        [HANDLE_SUBS_REGISTER_32] = HANDLE_SUBS_REGISTER_B_COND_32,
+    };
+
+    // Untranslated is never fused into, so marks every other handler.
+    if (fused[op->handler] == HANDLE_TRANSLATE || address + WORD_SIZE >= LOW_MEMORY_SIZE) return;
+
+    // Only decode what is certainly a conditional branch, lest decoding anything else raise an error early.
+    Instruction next = readMem(memory, false, address + WORD_SIZE);
+    if ((next & BRANCH_CONDITIONAL_M) != BRANCH_CONDITIONAL_B) return;
+
+    ThreadedOp branch;
+    translateOp(&branch, memory, address + WORD_SIZE);
+    if (branch.handler != HANDLE_B_COND) return;
+
+    op->handler = fused[op->handler];
+    op->truth = branch.truth;
+    op->target = branch.imm;
+}
@@ -0,0 +1,136 @@
+///
+/// threaded.h
+/// A direct-threaded interpreter, dispatching on flat per-instruction handlers with computed goto.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_THREADED_H
+#define EMULATOR_THREADED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+#include "blockCache.h"
+#include "conditions.h"
+#include "const.h"
+#include "error.h"
+#include "ir.h"
+#include "memory.h"
+#include "registers.h"
+
+/// The handlers of the threaded interpreter: one per operation and operand width, so that each is
+/// straight-line code ending in its own dispatch.
+typedef enum {
+    HANDLE_TRANSLATE,
+    HANDLE_STEP,
+    HANDLE_HALT,
+    HANDLE_EXECUTE,
+    HANDLE_LOAD_STORE,
+
+    HANDLE_ADD_IMMEDIATE_64,
+    HANDLE_ADD_IMMEDIATE_32,
+    HANDLE_ADDS_IMMEDIATE_64,
+    HANDLE_ADDS_IMMEDIATE_32,
+    HANDLE_SUB_IMMEDIATE_64,
+    HANDLE_SUB_IMMEDIATE_32,
+    HANDLE_SUBS_IMMEDIATE_64,
+    HANDLE_SUBS_IMMEDIATE_32,
+    HANDLE_MOVE_WIDE,
+    HANDLE_MOVK_64,
+    HANDLE_MOVK_32,
+
+    HANDLE_ADD_REGISTER_64,
+    HANDLE_ADD_REGISTER_32,
+    HANDLE_ADDS_REGISTER_64,
+    HANDLE_ADDS_REGISTER_32,
+    HANDLE_SUB_REGISTER_64,
+    HANDLE_SUB_REGISTER_32,
+    HANDLE_SUBS_REGISTER_64,
+    HANDLE_SUBS_REGISTER_32,
+    HANDLE_AND_64,
+    HANDLE_AND_32,
+    HANDLE_ORR_64,
+    HANDLE_ORR_32,
+    HANDLE_EOR_64,
+    HANDLE_EOR_32,
+    HANDLE_ANDS_64,
+    HANDLE_ANDS_32,
+    HANDLE_MADD_64,
+    HANDLE_MADD_32,
+    HANDLE_MSUB_64,
+    HANDLE_MSUB_32,
+
+    HANDLE_B,
+    HANDLE_B_COND,
+    HANDLE_BR,
+
+    HANDLE_SUBS_IMMEDIATE_B_COND_64,
+    HANDLE_SUBS_IMMEDIATE_B_COND_32,
+    HANDLE_SUBS_REGISTER_B_COND_64,
+    HANDLE_SUBS_REGISTER_B_COND_32,
+
+    HANDLE_COUNT
+} Handler;
+
+/// An instruction translated for the threaded interpreter, with its operands pre-extracted.
+typedef struct {
+    /// The handler to dispatch to. Zeroed memory is [HANDLE_TRANSLATE], i.e., untranslated.
+    Handler handler;
+
+    /// The destination (or transfer) register.
+    uint8_t rd;
+
+    /// The first source register.
+    uint8_t rn;
+
+    /// The second source register.
+    uint8_t rm;
+
+    /// The accumulator register of a multiply.
+    uint8_t ra;
+
+    /// The shift applied to [rm], or to the immediate of a \code movk \endcode.
+    enum ShiftType shift;
+
+    /// The amount of [shift].
+    uint8_t amount;
+
+    /// XOR-ed into the second operand, i.e., all ones for negated bit-logic.
+    uint64_t invert;
+
+    /// The immediate operand, or the slot of a branch target.
+    uint64_t imm;
+
+    /// The truth table of a conditional branch's condition, as per [conditionTruthTable].
+    uint16_t truth;
+
+    /// The slot of the branch target of a compare fused with the conditional branch after it.
+    uint64_t target;
+
+    /// The decoded instruction, for handlers which defer to its executor.
+    IR *ir;
+
+    /// The executor of [ir].
+    Executor execute;
+} ThreadedOp;
+
+/// The [ThreadedOp]s translated from a memory, one per word of it.
+struct ThreadedCode_s {
+    /// The [ThreadedOp]s, anonymously mapped so that only the pages covering code are ever touched.
+    ThreadedOp *ops;
+
+    /// The [Memory_s.codeVersion] that every op was translated under.
+    uint64_t codeVersion;
+};
+
+ThreadedCode createThreadedCode(void);
+
+void destroyThreadedCode(ThreadedCode code);
+
+void flushThreadedCode(ThreadedCode code);
+
+bool runThreaded(Registers registers, Memory memory, uint64_t limit);
+
+#endif // EMULATOR_THREADED_H
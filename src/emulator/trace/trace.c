@@ -0,0 +1,382 @@
+///
+/// trace.c
+/// Records every instruction of a run, and what it changed, to a compact binary trace; and reads it back.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "trace.h"
+
+static void *drainTrace(void *argument);
+
+static void emit(Trace trace, const uint8_t *bytes, size_t length);
+
+static void putByte(Trace trace, uint8_t byte);
+
+static void putVarint(Trace trace, uint64_t value);
+
+static void traceRetire(void *context, const Registers_s *registers, Memory memory, BitData pc, Instruction word);
+
+static void traceAccess(void *context, const MemoryAccess *access);
+
+static void initialiseState(TraceState *state, const uint64_t *header);
+
+static bool rememberWord(TraceState *state, BitData pc, Instruction word);
+
+static uint8_t getByte(TraceReader reader);
+
+static uint64_t getVarint(TraceReader reader);
+
+static uint64_t zigzag(uint64_t difference);
+
+static uint64_t unzigzag(uint64_t code);
+
+/// The number of words in a trace's header, after its magic number: the PC, instruction count, general purpose
+/// registers, stack pointer, and NZCV.
+#define HEADER_WORDS       (NO_GPRS + 4)
+
+/// Creates a trace file, starts the thread writing to it, and starts recording every instruction run over [memory].
+/// @param path The path of the file.
+/// @param registers The registers the traced run starts from, and which must be the only ones run over [memory].
+/// @param memory The virtual memory.
+/// @returns The trace, to be closed by [closeTrace].
+/// @remark The file is only meant to be read by this same build of the emulator, on the same host. An instruction
+/// which faults is not recorded.
+Trace openTrace(const char *path, Registers registers, Memory memory) {
+    FILE *file = fopen(path, "wb");
+    assertFatalNotNullWithArgs(file, "Unable to open trace file '%s'!", path);
+
+    Trace trace = calloc(1, sizeof(Trace_s));
+    assertFatalNotNull(trace, "<Trace> Unable to allocate [Trace_s]!");
+
+    trace->ring = malloc(TRACE_RING_SIZE);
+    assertFatalNotNull(trace->ring, "<Trace> Unable to allocate ring buffer!");
+    trace->file = file;
+    trace->memory = memory;
+
+    uint64_t header[HEADER_WORDS] = { registers->pc, registers->instructions };
+    memcpy(&header[2], registers->gprs, sizeof(registers->gprs));
+    header[2 + TRACE_SP] = registers->sp;
+    header[HEADER_WORDS - 1] = getRegNZCV(registers);
+    initialiseState(&trace->state, header);
+
+    emit(trace, (const uint8_t *) TRACE_MAGIC, sizeof(TRACE_MAGIC) - 1);
+    emit(trace, (const uint8_t *) header, sizeof(header));
+
+    assertFatal(pthread_create(&trace->writer, NULL, drainTrace, trace) == 0, "<Trace> Unable to start writer!");
+
+    addRetireHook(memory, traceRetire, trace);
+    addReadHook(memory, traceAccess, trace);
+    addWriteHook(memory, traceAccess, trace);
+    return trace;
+}
+
+/// Stops recording, ends the trace, waits for every record to be written to its file, then closes it.
+/// @param trace The trace.
+/// @param reason Why the traced run stopped.
+void closeTrace(Trace trace, StopReason reason) {
+    removeHooks(trace->memory, trace);
+
+    trace->length = 0;
+    putByte(trace, TRACE_END);
+    putByte(trace, reason);
+    putVarint(trace, trace->state.instructions);
+    emit(trace, trace->record, trace->length);
+
+    __atomic_store_n(&trace->done, true, __ATOMIC_RELEASE);
+    pthread_join(trace->writer, NULL);
+
+    bool failed = fclose(trace->file) != 0 || trace->failed;
+    free(trace->ring);
+    free(trace);
+    assertFatal(!failed, "Unable to write trace file!");
+}
+
+/// Opens a trace file written by [openTrace] and [closeTrace] for reading.
+/// @param path The path of the file.
+/// @returns The reader, to be closed by [closeTraceReader].
+TraceReader openTraceReader(const char *path) {
+    FILE *file = fopen(path, "rb");
+    assertFatalNotNullWithArgs(file, "Unable to open trace file '%s'!", path);
+
+    char magic[sizeof(TRACE_MAGIC) - 1];
+    uint64_t header[HEADER_WORDS];
+    bool valid = fread(magic, sizeof(magic), 1, file) == 1 && memcmp(magic, TRACE_MAGIC, sizeof(magic)) == 0
+                 && fread(header, sizeof(header), 1, file) == 1;
+    if (!valid) fclose(file);
+    assertFatalWithArgs(valid, "'%s' is not a trace written by this emulator!", path);
+
+    TraceReader reader = malloc(sizeof(TraceReader_s));
+    assertFatalNotNull(reader, "<Trace> Unable to allocate [TraceReader_s]!");
+
+    reader->file = file;
+    reader->path = path;
+    reader->reason = STOP_FAULT;
+    initialiseState(&reader->state, header);
+    return reader;
+}
+
+/// Reads the next record of a trace.
+/// @param reader The reader.
+/// @param record Where to decode the record to.
+/// @returns Whether there was a record, rather than the end of the trace; once there is not, [TraceReader_s.reason]
+/// and [TraceState.instructions] hold how the run ended.
+bool readTraceRecord(TraceReader reader, TraceRecord *record) {
+    TraceState *state = &reader->state;
+    uint8_t header = getByte(reader);
+
+    if (header == TRACE_END) {
+        reader->reason = (StopReason) getByte(reader);
+        state->instructions = getVarint(reader);
+        return false;
+    }
+
+    record->index = state->instructions++;
+    record->pc = state->nextPC + unzigzag(getVarint(reader));
+    state->nextPC = record->pc + WORD_SIZE;
+
+    if (header & TRACE_WORD) {
+        record->word = 0;
+        for (size_t i = 0; i < sizeof(Instruction); i++) record->word |= (Instruction) getByte(reader) << i * 8;
+        rememberWord(state, record->pc, record->word);
+    } else {
+        record->word = state->words[record->pc / WORD_SIZE % TRACE_WORD_CACHE];
+    }
+
+    record->accessCount = header >> TRACE_ACCESSES_SHIFT & 0x3;
+    for (size_t i = 0; i < record->accessCount; i++) {
+        TraceAccess *access = &record->accesses[i];
+        uint8_t kind = getByte(reader);
+        access->write = kind & 1;
+        access->as64 = kind >> 1 & 1;
+        access->address = state->nextAddress + unzigzag(getVarint(reader));
+        access->value = getVarint(reader);
+        state->nextAddress = access->address + (access->as64 ? sizeof(uint64_t) : sizeof(uint32_t));
+    }
+
+    record->writeCount = header >> TRACE_WRITES_SHIFT & 0x7;
+    for (size_t i = 0; i < record->writeCount; i++) {
+        uint8_t id = getByte(reader);
+        assertFatalWithArgs(id <= TRACE_SP, "Trace file '%s' is corrupt!", reader->path);
+        record->registers[i] = id;
+        record->values[i] = state->registers[id] += unzigzag(getVarint(reader));
+    }
+
+    record->flagsChanged = header & TRACE_NZCV;
+    if (record->flagsChanged) state->nzcv = getByte(reader);
+    record->nzcv = state->nzcv;
+
+    return true;
+}
+
+/// Closes the given trace reader.
+/// @param reader The reader.
+void closeTraceReader(TraceReader reader) {
+    fclose(reader->file);
+    free(reader);
+}
+
+/// Writes the trace's ring buffer out to its file as it fills, until the run is done and the ring is empty.
+/// @param argument The [Trace].
+/// @returns NULL.
+static void *drainTrace(void *argument) {
+    Trace trace = argument;
+    struct timespec pause = { .tv_sec = 0, .tv_nsec = 100000 };
+
+    while (true) {
+        // Check [done] first, so that every record put before it was set is seen.
+        bool done = __atomic_load_n(&trace->done, __ATOMIC_ACQUIRE);
+        uint64_t head = __atomic_load_n(&trace->head, __ATOMIC_ACQUIRE);
+
+        if (head == trace->tail) {
+            if (done) break;
+            nanosleep(&pause, NULL);
+            continue;
+        }
+
+        // Write up to the head, or the end of the ring, whichever is first.
+        size_t offset = trace->tail & (TRACE_RING_SIZE - 1);
+        size_t length = head - trace->tail;
+        if (length > TRACE_RING_SIZE - offset) length = TRACE_RING_SIZE - offset;
+
+        if (fwrite(trace->ring + offset, 1, length, trace->file) != length) trace->failed = true;
+        __atomic_store_n(&trace->tail, trace->tail + length, __ATOMIC_RELEASE);
+    }
+
+    return NULL;
+}
+
+/// Puts bytes into the trace's ring buffer, waiting for the writer thread to make room for them if need be.
+/// @param trace The trace.
+/// @param bytes The bytes.
+/// @param length The number of [bytes].
+static void emit(Trace trace, const uint8_t *bytes, size_t length) {
+    uint64_t head = trace->head;
+    while (head + length - __atomic_load_n(&trace->tail, __ATOMIC_ACQUIRE) > TRACE_RING_SIZE) sched_yield();
+
+    size_t offset = head & (TRACE_RING_SIZE - 1);
+    size_t first = length < TRACE_RING_SIZE - offset ? length : TRACE_RING_SIZE - offset;
+    memcpy(trace->ring + offset, bytes, first);
+    memcpy(trace->ring, bytes + first, length - first);
+
+    __atomic_store_n(&trace->head, head + length, __ATOMIC_RELEASE);
+}
+
+/// Appends a byte to the record being encoded.
+/// @param trace The trace.
+/// @param byte The byte.
+static void putByte(Trace trace, uint8_t byte) {
+    trace->record[trace->length++] = byte;
+}
+
+/// Appends an unsigned LEB128 varint to the record being encoded.
+/// @param trace The trace.
+/// @param value The value.
+static void putVarint(Trace trace, uint64_t value) {
+    while (value >= 0x80) {
+        putByte(trace, (uint8_t) (value | 0x80));
+        value >>= 7;
+    }
+    putByte(trace, (uint8_t) value);
+}
+
+/// Records an instruction which has executed, the accesses it made, and what it changed.
+/// @param context The trace.
+/// @param registers The virtual registers, as the instruction left them.
+/// @param memory The virtual memory.
+/// @param pc The address of the instruction.
+/// @param word The instruction.
+/// @remark A record is laid out as
+/// \code header, pc, word?, (kind, address, value) per memory access, (register, value) per write, nzcv? \endcode
+/// where the PC is relative to just after the last instruction, each address to just after the last access, and each
+/// register value to its last; all as varints.
+static void traceRetire(void *context, const Registers_s *registers, unused Memory memory,
+                        BitData pc, Instruction word) {
+    Trace trace = context;
+    TraceState *state = &trace->state;
+
+    // The header is only known once the whole record is.
+    trace->length = 1;
+    putVarint(trace, zigzag(pc - state->nextPC));
+
+    uint8_t header = 0;
+    if (rememberWord(state, pc, word)) {
+        header |= TRACE_WORD;
+        for (size_t i = 0; i < sizeof(Instruction); i++) putByte(trace, (uint8_t) (word >> i * 8));
+    }
+
+    header |= trace->accessCount << TRACE_ACCESSES_SHIFT;
+    for (size_t i = 0; i < trace->accessCount; i++) {
+        TraceAccess *access = &trace->accesses[i];
+        putByte(trace, access->write | access->as64 << 1);
+        putVarint(trace, zigzag(access->address - state->nextAddress));
+        putVarint(trace, access->value);
+        state->nextAddress = access->address + (access->as64 ? sizeof(uint64_t) : sizeof(uint32_t));
+    }
+    trace->accessCount = 0;
+
+    size_t writes = 0;
+    for (uint8_t id = 0; id <= TRACE_SP; id++) {
+        BitData value = id == TRACE_SP ? registers->sp : registers->gprs[id];
+        if (value == state->registers[id]) continue;
+
+        assertFatal(writes < TRACE_MAX_WRITES, "<Trace> Too many register writes by one instruction!");
+        writes++;
+        putByte(trace, id);
+        putVarint(trace, zigzag(value - state->registers[id]));
+        state->registers[id] = value;
+    }
+    header |= writes << TRACE_WRITES_SHIFT;
+
+    uint8_t nzcv = getRegNZCV(registers);
+    if (nzcv != state->nzcv) {
+        header |= TRACE_NZCV;
+        putByte(trace, nzcv);
+        state->nzcv = nzcv;
+    }
+
+    trace->record[0] = header;
+    emit(trace, trace->record, trace->length);
+
+    state->nextPC = pc + WORD_SIZE;
+    state->instructions++;
+}
+
+/// Notes a memory access made by the instruction executing, to be recorded once it has executed.
+/// @param context The trace.
+/// @param access The access.
+static void traceAccess(void *context, const MemoryAccess *access) {
+    Trace trace = context;
+    assertFatal(trace->accessCount < TRACE_MAX_ACCESSES, "<Trace> Too many memory accesses by one instruction!");
+
+    trace->accesses[trace->accessCount++] = (TraceAccess) {
+        .write = access->write, .as64 = access->as64, .address = access->address, .value = access->value
+    };
+}
+
+/// Initialises the state a trace is encoded against from its header.
+/// @param state The state.
+/// @param header The header, of [HEADER_WORDS] words.
+static void initialiseState(TraceState *state, const uint64_t *header) {
+    state->nextPC = header[0];
+    state->nextAddress = 0;
+    state->instructions = header[1];
+    memcpy(state->registers, &header[2], sizeof(state->registers));
+    state->nzcv = (uint8_t) header[HEADER_WORDS - 1];
+
+    for (size_t i = 0; i < TRACE_WORD_CACHE; i++) {
+        state->wordAddresses[i] = UINT64_MAX;
+        state->words[i] = 0;
+    }
+}
+
+/// Remembers [word] as the instruction at [pc].
+/// @param state The state.
+/// @param pc The address of the instruction.
+/// @param word The instruction.
+/// @returns Whether it was not already remembered, so must be recorded.
+static bool rememberWord(TraceState *state, BitData pc, Instruction word) {
+    size_t slot = pc / WORD_SIZE % TRACE_WORD_CACHE;
+    if (state->wordAddresses[slot] == pc && state->words[slot] == word) return false;
+
+    state->wordAddresses[slot] = pc;
+    state->words[slot] = word;
+    return true;
+}
+
+/// Reads a byte of a trace.
+/// @param reader The reader.
+/// @returns The byte.
+static uint8_t getByte(TraceReader reader) {
+    int byte = fgetc(reader->file);
+    assertFatalWithArgs(byte != EOF, "Trace file '%s' is truncated!", reader->path);
+    return (uint8_t) byte;
+}
+
+/// Reads an unsigned LEB128 varint of a trace.
+/// @param reader The reader.
+/// @returns The value.
+static uint64_t getVarint(TraceReader reader) {
+    uint64_t value = 0;
+    for (size_t shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = getByte(reader);
+        value |= (uint64_t) (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+
+    throwFatalWithArgs("Trace file '%s' is corrupt!", reader->path);
+}
+
+/// Zig-zag encodes a (two's complement) difference, so that small differences either way are small varints.
+/// @param difference The difference.
+/// @returns The encoded difference.
+static uint64_t zigzag(uint64_t difference) {
+    return difference << 1 ^ (uint64_t) ((int64_t) difference >> 63);
+}
+
+/// Decodes a zig-zag encoded difference.
+/// @param code The encoded difference.
+/// @returns The difference.
+static uint64_t unzigzag(uint64_t code) {
+    return code >> 1 ^ -(code & 1);
+}
@@ -0,0 +1,212 @@
+///
+/// trace.h
+/// Records every instruction of a run, and what it changed, to a compact binary trace; and reads it back.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_TRACE_H
+#define EMULATOR_TRACE_H
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "const.h"
+#include "emulatorDelegate.h"
+#include "error.h"
+#include "hooks.h"
+#include "memory.h"
+#include "registers.h"
+
+/// The magic number a trace file starts with, followed by its format version.
+#define TRACE_MAGIC          "A64TRAC\x01"
+
+/// The number of bytes in a [Trace]'s ring buffer. Must be a power of two.
+#define TRACE_RING_SIZE      ((size_t) 1 << 20)
+
+/// The most bytes any one record of a trace takes.
+#define TRACE_RECORD_MAX     256
+
+/// The number of instruction words remembered by address, so that each is only written the first time it is seen.
+/// Must be a power of two.
+#define TRACE_WORD_CACHE     4096
+
+/// The most memory accesses recorded for one instruction.
+#define TRACE_MAX_ACCESSES   3
+
+/// The most register writes recorded for one instruction.
+#define TRACE_MAX_WRITES     7
+
+/// The index a write to the stack pointer is recorded under, after the general purpose registers.
+#define TRACE_SP             NO_GPRS
+
+/// Bit of a record's header marking that its instruction word follows, i.e., was not remembered for its address.
+#define TRACE_WORD           0x01
+
+/// The offset of the count of memory accesses in a record's header.
+#define TRACE_ACCESSES_SHIFT 1
+
+/// The offset of the count of register writes in a record's header.
+#define TRACE_WRITES_SHIFT   3
+
+/// Bit of a record's header marking that NZCV changed, and follows.
+#define TRACE_NZCV           0x40
+
+/// The header of the record ending a trace, followed by why the run stopped and its final instruction count.
+#define TRACE_END            0x80
+
+/// A memory access made by an instruction.
+typedef struct {
+    /// Whether the access was a write, rather than a read.
+    bool write;
+
+    /// Whether the access was of 64, rather than 32, bits.
+    bool as64;
+
+    /// The address accessed.
+    BitData address;
+
+    /// The value read or written.
+    BitData value;
+} TraceAccess;
+
+/// An instruction executed, and what it changed.
+typedef struct {
+    /// The number of instructions executed before this one.
+    uint64_t index;
+
+    /// The address of the instruction.
+    BitData pc;
+
+    /// The instruction.
+    Instruction word;
+
+    /// The memory accesses it made, in order.
+    TraceAccess accesses[TRACE_MAX_ACCESSES];
+
+    /// The number of [accesses].
+    size_t accessCount;
+
+    /// The registers it wrote, by index, with [TRACE_SP] for the stack pointer.
+    uint8_t registers[TRACE_MAX_WRITES];
+
+    /// The values written to [registers].
+    BitData values[TRACE_MAX_WRITES];
+
+    /// The number of [registers].
+    size_t writeCount;
+
+    /// Whether it changed NZCV.
+    bool flagsChanged;
+
+    /// NZCV after it, as per [getRegNZCV].
+    uint8_t nzcv;
+} TraceRecord;
+
+/// The state a trace is encoded against, kept alike by its writer and reader so that records can be delta-encoded.
+typedef struct {
+    /// The address the next instruction is expected at, i.e., just after the last.
+    BitData nextPC;
+
+    /// The address just after the last memory access.
+    BitData nextAddress;
+
+    /// The general purpose registers, then the stack pointer.
+    BitData registers[NO_GPRS + 1];
+
+    /// NZCV, as per [getRegNZCV].
+    uint8_t nzcv;
+
+    /// The number of instructions executed.
+    uint64_t instructions;
+
+    /// The address of each of [words].
+    BitData wordAddresses[TRACE_WORD_CACHE];
+
+    /// The last instruction word seen at each of [wordAddresses].
+    Instruction words[TRACE_WORD_CACHE];
+} TraceState;
+
+/// A trace being written, whose records are encoded into a ring buffer that a writer thread drains to its file.
+/// @remark The ring has a single producer, the run, and a single consumer, the writer thread, so needs no lock: each
+/// only advances its own end of it. A full ring makes the run wait for the writer, so no record is ever dropped.
+typedef struct Trace_s {
+    /// The file written to.
+    FILE *file;
+
+    /// The ring buffer.
+    uint8_t *ring;
+
+    /// The number of bytes ever put into [ring], advanced only by the run.
+    uint64_t head;
+
+    /// The number of bytes ever written out of [ring], advanced only by the writer thread.
+    uint64_t tail;
+
+    /// Whether the run has finished, so that the writer thread should stop once [ring] is empty.
+    bool done;
+
+    /// Whether writing to [file] failed.
+    bool failed;
+
+    /// The writer thread.
+    pthread_t writer;
+
+    /// The memory whose instructions are recorded.
+    Memory memory;
+
+    /// The state records are encoded against.
+    TraceState state;
+
+    /// The record being encoded.
+    uint8_t record[TRACE_RECORD_MAX];
+
+    /// The number of bytes of [record] encoded so far.
+    size_t length;
+
+    /// The memory accesses made so far by the instruction executing.
+    TraceAccess accesses[TRACE_MAX_ACCESSES];
+
+    /// The number of [accesses].
+    size_t accessCount;
+} Trace_s;
+
+/// Type definition of a pointer to [Trace_s].
+typedef Trace_s *Trace;
+
+/// A trace being read.
+typedef struct {
+    /// The file read from.
+    FILE *file;
+
+    /// The path of [file], for errors.
+    const char *path;
+
+    /// The state records are decoded against.
+    TraceState state;
+
+    /// Why the traced run stopped, once the end of the trace has been read.
+    StopReason reason;
+} TraceReader_s;
+
+/// Type definition of a pointer to [TraceReader_s].
+typedef TraceReader_s *TraceReader;
+
+Trace openTrace(const char *path, Registers registers, Memory memory);
+
+void closeTrace(Trace trace, StopReason reason);
+
+TraceReader openTraceReader(const char *path);
+
+bool readTraceRecord(TraceReader reader, TraceRecord *record);
+
+void closeTraceReader(TraceReader reader);
+
+#endif // EMULATOR_TRACE_H
@@ -0,0 +1,320 @@
+///
+/// undoLog.c
+/// A bounded log of what each step of a run changed, so that the run can be stepped and continued backwards.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "undoLog.h"
+
+static void push(UndoLog log, uint64_t word);
+
+static uint64_t pop(UndoLog log);
+
+static void clearLog(UndoLog log);
+
+static void addCheckpoint(UndoLog log, Registers registers, Memory memory);
+
+static bool seek(UndoLog log, Registers registers, Memory memory, uint64_t target);
+
+static bool flagsEqual(Registers a, Registers b);
+
+static void journalWrite(void *context, const MemoryAccess *access);
+
+/// Creates an undo log for a run, checkpointing it where it is now.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @param capacity The number of words in the log's ring, e.g., [UNDO_LOG_WORDS].
+/// @returns The undo log, to be freed by [freeUndoLog].
+/// @remark The run can be stepped back to where it is now, but no further.
+UndoLog createUndoLog(Registers registers, Memory memory, size_t capacity) {
+    UndoLog log = malloc(sizeof(UndoLog_s));
+    assertFatalNotNull(log, "<UndoLog> Unable to allocate [UndoLog_s]!");
+
+    log->words = malloc(capacity * sizeof(uint64_t));
+    assertFatalNotNull(log->words, "<UndoLog> Unable to allocate log!");
+    log->capacity = capacity;
+    clearLog(log);
+
+    log->checkpoints = malloc(UNDO_MAX_CHECKPOINTS * sizeof(Snapshot));
+    assertFatalNotNull(log->checkpoints, "<UndoLog> Unable to allocate checkpoints!");
+    log->checkpointCount = 0;
+    log->interval = UNDO_CHECKPOINT_INTERVAL;
+    addCheckpoint(log, registers, memory);
+
+    return log;
+}
+
+/// Executes the instruction at the PC, recording what it changes so that it can be undone by [stepBack].
+/// @param log The undo log.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @returns [STOP_BUDGET] once the instruction has executed, [STOP_HALTED] if it is a halt, or [STOP_FAULT] if it
+/// raised a fatal error, whose message is left in [fatalError].
+/// @remark A halt is not executed, and a fault is rolled back, so that either leaves the registers and memory exactly
+/// as they were. Writes to devices are not journaled, so are never undone.
+StopReason stepForward(UndoLog log, Registers registers, Memory memory) {
+    Snapshot last = log->checkpoints[log->checkpointCount - 1];
+    if (registers->instructions >= last->registers.instructions + log->interval) {
+        addCheckpoint(log, registers, memory);
+    }
+
+    Registers_s before = *registers;
+
+    // The length of the record is only known once the step is complete.
+    log->start = log->head;
+    log->writes = 0;
+    push(log, 0);
+    push(log, before.pc);
+
+    addWriteHook(memory, journalWrite, log);
+    StopReason reason = runFor(registers, memory, REFERENCE_ENGINE, 1);
+    removeHooks(memory, log);
+
+    if (reason != STOP_BUDGET) {
+        for (; log->writes > 0; log->writes--) {
+            BitData old = pop(log);
+            BitData target = pop(log);
+            writeMem(memory, target & 1, target >> 1, old);
+        }
+        pop(log);
+        pop(log);
+
+        *registers = before;
+        return reason;
+    }
+
+    uint64_t header = (uint64_t) log->writes << UNDO_WRITES_SHIFT;
+
+    for (size_t i = 0; i < NO_GPRS; i++) {
+        if (registers->gprs[i] == before.gprs[i]) continue;
+        push(log, before.gprs[i]);
+        header |= (uint64_t) 1 << i;
+    }
+
+    if (registers->sp != before.sp) {
+        push(log, before.sp);
+        header |= UNDO_SP;
+    }
+
+    if (!flagsEqual(registers, &before)) {
+        push(log, before.pstate.ng | before.pstate.zr << 1 | before.pstate.cr << 2 | before.pstate.ov << 3
+                  | before.flags.source << 4 | (uint64_t) before.flags.sf << 6);
+        push(log, before.flags.rn);
+        push(log, before.flags.op2);
+        push(log, before.flags.res);
+        header |= UNDO_FLAGS;
+    }
+
+    if (registers->exclusive != before.exclusive || registers->exclusiveAddress != before.exclusiveAddress
+        || registers->exclusiveValue != before.exclusiveValue) {
+        push(log, before.exclusive);
+        push(log, before.exclusiveAddress);
+        push(log, before.exclusiveValue);
+        header |= UNDO_MONITOR;
+    }
+
+    push(log, header);
+    log->words[log->start] = (log->head + log->capacity - log->start) % log->capacity;
+    log->records++;
+
+    return STOP_BUDGET;
+}
+
+/// Undoes the last instruction executed.
+/// @param log The undo log.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @returns Whether there was an instruction to undo, i.e., whether the run is past where [log] was created.
+/// @remark Once the log's records are exhausted, the run is replayed from the last checkpoint before the target,
+/// recording as it goes, so that the steps before that are cheap to undo again.
+bool stepBack(UndoLog log, Registers registers, Memory memory) {
+    if (log->records == 0) {
+        if (registers->instructions <= log->checkpoints[0]->registers.instructions) return false;
+        return seek(log, registers, memory, registers->instructions - 1);
+    }
+
+    uint64_t header = pop(log);
+
+    if (header & UNDO_MONITOR) {
+        registers->exclusiveValue = pop(log);
+        registers->exclusiveAddress = pop(log);
+        registers->exclusive = pop(log);
+    }
+
+    if (header & UNDO_FLAGS) {
+        registers->flags.res = pop(log);
+        registers->flags.op2 = pop(log);
+        registers->flags.rn = pop(log);
+
+        uint64_t packed = pop(log);
+        registers->pstate = (PState) {
+            .ng = packed & 1, .zr = packed >> 1 & 1, .cr = packed >> 2 & 1, .ov = packed >> 3 & 1
+        };
+        registers->flags.source = (FlagSource) (packed >> 4 & 3);
+        registers->flags.sf = packed >> 6 & 1;
+    }
+
+    if (header & UNDO_SP) registers->sp = pop(log);
+
+    for (size_t i = NO_GPRS; i-- > 0;) {
+        if (header & (uint64_t) 1 << i) registers->gprs[i] = pop(log);
+    }
+
+    // Undo the writes in the reverse of the order they were made in.
+    for (size_t writes = header >> UNDO_WRITES_SHIFT; writes > 0; writes--) {
+        BitData old = pop(log);
+        BitData target = pop(log);
+        writeMem(memory, target & 1, target >> 1, old);
+    }
+
+    registers->pc = pop(log);
+    pop(log);
+
+    registers->instructions--;
+    log->records--;
+    return true;
+}
+
+/// Steps back until the PC is [pc], i.e., to just before the last time the instruction at [pc] was executed.
+/// @param log The undo log.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @param pc The address of the instruction to stop at.
+/// @returns Whether it was found; if not, the run is left where [log] was created.
+bool reverseToPC(UndoLog log, Registers registers, Memory memory, BitData pc) {
+    while (stepBack(log, registers, memory)) {
+        if (getRegPC(registers) == pc) return true;
+    }
+
+    return false;
+}
+
+/// Steps back until just before the last instruction which changed the value at [addr].
+/// @param log The undo log.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @param as64 Whether to watch 64 or 32 bits.
+/// @param addr The address to watch, which must not be a device's.
+/// @returns Whether it was found; if not, the run is left where [log] was created.
+bool reverseToWrite(UndoLog log, Registers registers, Memory memory, bool as64, BitData addr) {
+    BitData value = readMem(memory, as64, addr);
+    while (stepBack(log, registers, memory)) {
+        if (readMem(memory, as64, addr) != value) return true;
+    }
+
+    return false;
+}
+
+/// Frees the given undo log, and its checkpoints.
+/// @param log The undo log.
+void freeUndoLog(UndoLog log) {
+    for (size_t i = 0; i < log->checkpointCount; i++) freeSnapshot(log->checkpoints[i]);
+    free(log->checkpoints);
+    free(log->words);
+    free(log);
+}
+
+/// Appends a word to the record being written, dropping the oldest records to make room for it.
+/// @param log The undo log.
+/// @param word The word.
+static void push(UndoLog log, uint64_t word) {
+    while (log->used == log->capacity) {
+        assertFatal(log->records > 0, "<UndoLog> A step does not fit in the log!");
+
+        size_t length = log->words[log->tail];
+        log->tail = (log->tail + length) % log->capacity;
+        log->used -= length;
+        log->records--;
+    }
+
+    log->words[log->head] = word;
+    log->head = (log->head + 1) % log->capacity;
+    log->used++;
+}
+
+/// Removes the newest word of the log.
+/// @param log The undo log.
+/// @returns The word.
+static uint64_t pop(UndoLog log) {
+    log->head = (log->head + log->capacity - 1) % log->capacity;
+    log->used--;
+    return log->words[log->head];
+}
+
+/// Drops every record of the log, leaving its checkpoints.
+/// @param log The undo log.
+static void clearLog(UndoLog log) {
+    log->tail = 0;
+    log->head = 0;
+    log->used = 0;
+    log->records = 0;
+    log->start = 0;
+    log->writes = 0;
+}
+
+/// Checkpoints the run where it is now.
+/// @param log The undo log.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @remark Once there are [UNDO_MAX_CHECKPOINTS], every other one (but the first) is dropped, and the interval
+/// between them doubled, so that they cover however long a run with bounded memory.
+static void addCheckpoint(UndoLog log, Registers registers, Memory memory) {
+    if (log->checkpointCount == UNDO_MAX_CHECKPOINTS) {
+        size_t kept = 1;
+        for (size_t i = 1; i < log->checkpointCount; i++) {
+            if (i % 2 == 0) {
+                log->checkpoints[kept++] = log->checkpoints[i];
+            } else {
+                freeSnapshot(log->checkpoints[i]);
+            }
+        }
+
+        log->checkpointCount = kept;
+        log->interval *= 2;
+    }
+
+    log->checkpoints[log->checkpointCount++] = takeSnapshot(registers, memory);
+}
+
+/// Moves the run to [target] instructions, by replaying it from the last checkpoint at or before then.
+/// @param log The undo log.
+/// @param registers The current virtual registers.
+/// @param memory The address of the virtual memory.
+/// @param target The instruction count to move to, no earlier than the first checkpoint.
+/// @returns Whether [target] was reached, which it always is unless a device makes the run replay differently.
+static bool seek(UndoLog log, Registers registers, Memory memory, uint64_t target) {
+    size_t checkpoint = log->checkpointCount - 1;
+    while (log->checkpoints[checkpoint]->registers.instructions > target) checkpoint--;
+
+    clearLog(log);
+    restoreSnapshot(log->checkpoints[checkpoint], registers, memory);
+
+    while (registers->instructions < target) {
+        if (stepForward(log, registers, memory) != STOP_BUDGET) return false;
+    }
+
+    return true;
+}
+
+/// Checks whether two sets of registers have the same PSTATE, and the same operation to evaluate it from.
+/// @param a The first set of registers.
+/// @param b The second set of registers.
+/// @returns Whether the flags of [a] and [b] are the same.
+static bool flagsEqual(Registers a, Registers b) {
+    return a->pstate.ng == b->pstate.ng && a->pstate.zr == b->pstate.zr && a->pstate.cr == b->pstate.cr
+           && a->pstate.ov == b->pstate.ov && a->flags.source == b->flags.source && a->flags.sf == b->flags.sf
+           && a->flags.rn == b->flags.rn && a->flags.op2 == b->flags.op2 && a->flags.res == b->flags.res;
+}
+
+/// Journals a write about to be made by the step being recorded, unless it is to a device.
+/// @param context The undo log.
+/// @param access The write.
+static void journalWrite(void *context, const MemoryAccess *access) {
+    if (access->device) return;
+
+    UndoLog log = context;
+    push(log, (uint64_t) access->address << 1 | access->as64);
+    push(log, access->old);
+    log->writes++;
+}
@@ -0,0 +1,104 @@
+///
+/// undoLog.h
+/// A bounded log of what each step of a run changed, so that the run can be stepped and continued backwards.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef EMULATOR_UNDO_LOG_H
+#define EMULATOR_UNDO_LOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "const.h"
+#include "emulatorDelegate.h"
+#include "error.h"
+#include "hooks.h"
+#include "memory.h"
+#include "registers.h"
+#include "snapshot.h"
+
+/// The default number of words in an [UndoLog]'s ring; a step takes a handful of words, so a few hundred thousand
+/// steps can be undone before falling back on a checkpoint.
+#define UNDO_LOG_WORDS          ((size_t) 1 << 20)
+
+/// The default number of instructions between checkpoints.
+#define UNDO_CHECKPOINT_INTERVAL 65536
+
+/// The most checkpoints an [UndoLog] keeps; once reached, every other one is dropped and the interval doubled.
+#define UNDO_MAX_CHECKPOINTS    64
+
+/// Bit of a record's header marking that the stack pointer changed.
+#define UNDO_SP                 ((uint64_t) 1 << 31)
+
+/// Bit of a record's header marking that PSTATE, or the operation its flags are evaluated from, changed.
+#define UNDO_FLAGS              ((uint64_t) 1 << 32)
+
+/// Bit of a record's header marking that the exclusive monitor changed.
+#define UNDO_MONITOR            ((uint64_t) 1 << 33)
+
+/// The offset of the count of memory writes in a record's header.
+#define UNDO_WRITES_SHIFT       40
+
+/// A log of the changes made by the most recent steps of a run, and checkpoints of the run to replay from once those
+/// steps are exhausted.
+/// @remark Each step is one record in a ring of words, laid out as
+/// \code length, pc, (address, old value) per memory write, old value per changed register, header \endcode
+/// where the header holds a bit per changed general purpose register, the [UNDO_SP], [UNDO_FLAGS], and
+/// [UNDO_MONITOR] bits, and the count of memory writes. Records are undone from the head, and the oldest dropped
+/// from the tail to make room for new ones.
+typedef struct UndoLog_s {
+    /// The ring of records.
+    uint64_t *words;
+
+    /// The number of [words].
+    size_t capacity;
+
+    /// The index of the first word of the oldest record.
+    size_t tail;
+
+    /// The index one past the last word of the newest record.
+    size_t head;
+
+    /// The number of words in use.
+    size_t used;
+
+    /// The number of records in the ring.
+    size_t records;
+
+    /// The index of the first word of the record being written, while a step is executing.
+    size_t start;
+
+    /// The number of memory writes made by the step being executed.
+    size_t writes;
+
+    /// Checkpoints of the run, in order of their instruction count; the first is where the log was created.
+    Snapshot *checkpoints;
+
+    /// The number of [checkpoints].
+    size_t checkpointCount;
+
+    /// The number of instructions between checkpoints.
+    uint64_t interval;
+} UndoLog_s;
+
+/// Type definition of a pointer to [UndoLog_s].
+typedef UndoLog_s *UndoLog;
+
+UndoLog createUndoLog(Registers registers, Memory memory, size_t capacity);
+
+StopReason stepForward(UndoLog log, Registers registers, Memory memory);
+
+bool stepBack(UndoLog log, Registers registers, Memory memory);
+
+bool reverseToPC(UndoLog log, Registers registers, Memory memory, BitData pc);
+
+bool reverseToWrite(UndoLog log, Registers registers, Memory memory, bool as64, BitData addr);
+
+void freeUndoLog(UndoLog log);
+
+#endif // EMULATOR_UNDO_LOG_H
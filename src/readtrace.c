@@ -0,0 +1,65 @@
+///
+/// readtrace.c
+/// Decodes a trace written by \code emulate --trace \endcode back into text.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#include "readtrace.h"
+
+/// The human-readable names of [StopReason].
+static const char *reasons[] = { "halted", "ran out of instructions", "faulted" };
+
+/// The entrypoint to the trace reader.
+/// @param argc Number of arguments. Should be 2 or 3.
+/// @param argv Arguments. In order: executable name, trace in, and (optionally) text out.
+/// @return Program exit code.
+/// @example \code ./readtrace run.trace run.txt \endcode
+int main(int argc, char **argv) {
+    if (argc != 2 && argc != 3) {
+        printf("Usage: ./readtrace run.trace [out.txt]\n");
+        return EXIT_FAILURE;
+    }
+
+    TraceReader reader = openTraceReader(argv[1]);
+
+    FILE *fileOut = stdout;
+    if (argc == 3) fileOut = fopen(argv[2], "w");
+    assertFatalNotNull(fileOut, "Unable to open output file!");
+
+    // One line per instruction, followed by an indented line per access and register it wrote.
+    TraceRecord record;
+    while (readTraceRecord(reader, &record)) {
+        IR ir = getDecodeFunction(record.word)(record.word);
+        char *description = adecl(&ir);
+        fprintf(fileOut, "%" PRIu64 ": 0x%016" PRIx64 ": %08" PRIx32 "  %s\n",
+                record.index, record.pc, record.word, description);
+        free(description);
+
+        for (size_t i = 0; i < record.accessCount; i++) {
+            TraceAccess *access = &record.accesses[i];
+            fprintf(fileOut, "    %s%s [0x%016" PRIx64 "] = 0x%0*" PRIx64 "\n", access->write ? "write" : "read ",
+                    access->as64 ? "64" : "32", access->address, access->as64 ? 16 : 8, access->value);
+        }
+
+        for (size_t i = 0; i < record.writeCount; i++) {
+            if (record.registers[i] == TRACE_SP) {
+                fprintf(fileOut, "    SP     = %016" PRIx64 "\n", record.values[i]);
+            } else {
+                fprintf(fileOut, "    X%02d    = %016" PRIx64 "\n", record.registers[i], record.values[i]);
+            }
+        }
+
+        if (record.flagsChanged) {
+            fprintf(fileOut, "    PSTATE : %c%c%c%c\n", record.nzcv & 0x8 ? 'N' : '-', record.nzcv & 0x4 ? 'Z' : '-',
+                    record.nzcv & 0x2 ? 'C' : '-', record.nzcv & 0x1 ? 'V' : '-');
+        }
+    }
+
+    fprintf(fileOut, "End of trace: %s after %" PRIu64 " instructions.\n",
+            reasons[reader->reason], reader->state.instructions);
+
+    closeTraceReader(reader);
+    if (fileOut != stdout) fclose(fileOut);
+    return EXIT_SUCCESS;
+}
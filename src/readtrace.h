@@ -0,0 +1,22 @@
+///
+/// readtrace.h
+/// Decodes a trace written by \code emulate --trace \endcode back into text.
+///
+/// Created by agent on 17/10/2026.
+///
+
+#ifndef READTRACE_H
+#define READTRACE_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "adecl.h"
+#include "emulatorDelegate.h"
+#include "ir.h"
+#include "trace.h"
+
+int main(int argc, char **argv);
+
+#endif // READTRACE_H